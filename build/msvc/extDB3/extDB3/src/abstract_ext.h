@@ -7,10 +7,12 @@
 
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "spdlog/spdlog.h"
 
 #include "mariaDB/pool.h"
+#include "results.h"
 
 
 #define EXTDB_VERSION "1.033"
@@ -28,6 +30,10 @@ public:
 
 	std::unordered_map<std::string, MariaDBPool> mariadb_databases;
 
+	// Streaming Result, unique_id 0 = new ID (Sync Call) else completes a reserved ID (Async Call)
+	//   Returns Unique ID, 0 = Result Store full / ID no longer reserved
+	virtual unsigned long saveResultStream(const unsigned long &unique_id, std::unique_ptr<ResultStream> &&stream) = 0;
+
 	// extInfo
 	struct extInfo
 	{
@@ -36,6 +42,10 @@ public:
 
 		bool logger_flush = true;
 
+		int game_core = -1;
+		std::vector<int> cpu_affinity;      // Worker Threads, empty = All Cores
+		std::vector<int> log_cpu_affinity;  // Logger + Timer Thread
+
 		bool extDB_lock = false;
 		std::string extDB_lockCode;
 
@@ -0,0 +1,133 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+
+template <typename T>
+class BoundedQueue
+// Bounded MPMC Queue (Dmitry Vyukov), same design as spdlog/details/mpmc_bounded_q.h
+//   Size is rounded up to power of 2, enqueue / dequeue never block + never allocate
+{
+public:
+	BoundedQueue(std::size_t queue_size)
+	{
+		buffer_size = 2;
+		while (buffer_size < queue_size)
+		{
+			buffer_size <<= 1;
+		}
+		buffer_mask = buffer_size - 1;
+		buffer.reset(new cell[buffer_size]);
+		for (std::size_t i = 0; i < buffer_size; ++i)
+		{
+			buffer[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	bool enqueue(T &&data)
+	{
+		cell *cell_ptr;
+		std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			cell_ptr = &buffer[pos & buffer_mask];
+			const std::size_t seq = cell_ptr->sequence.load(std::memory_order_acquire);
+			const std::intptr_t dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+			if (dif == 0)
+			{
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (dif < 0)
+			{
+				return false; // Full
+			}
+			else
+			{
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+		cell_ptr->data = std::move(data);
+		cell_ptr->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool dequeue(T &data)
+	{
+		cell *cell_ptr;
+		std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			cell_ptr = &buffer[pos & buffer_mask];
+			const std::size_t seq = cell_ptr->sequence.load(std::memory_order_acquire);
+			const std::intptr_t dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+			if (dif == 0)
+			{
+				if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (dif < 0)
+			{
+				return false; // Empty
+			}
+			else
+			{
+				pos = dequeue_pos.load(std::memory_order_relaxed);
+			}
+		}
+		data = std::move(cell_ptr->data);
+		cell_ptr->sequence.store(pos + buffer_mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	std::size_t size() const
+	// Approx Depth
+	{
+		const std::size_t first_pos = dequeue_pos.load(std::memory_order_relaxed);
+		const std::size_t last_pos = enqueue_pos.load(std::memory_order_relaxed);
+		if (last_pos <= first_pos)
+		{
+			return 0;
+		}
+		return ((last_pos - first_pos) < buffer_size) ? (last_pos - first_pos) : buffer_size;
+	}
+
+	std::size_t capacity() const
+	{
+		return buffer_size;
+	}
+
+private:
+	struct cell
+	{
+		std::atomic<std::size_t> sequence;
+		T data;
+	};
+
+	std::unique_ptr<cell[]> buffer;
+	std::size_t buffer_size;
+	std::size_t buffer_mask;
+
+	// Seperate Cache Lines, Producers (Game Thread) + Consumers (Worker Threads) don't false share
+	char pad0[64];
+	std::atomic<std::size_t> enqueue_pos{0};
+	char pad1[64];
+	std::atomic<std::size_t> dequeue_pos{0};
+	char pad2[64];
+
+	BoundedQueue(BoundedQueue const&) = delete;
+	void operator=(BoundedQueue const&) = delete;
+};
@@ -0,0 +1,494 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "executor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <boost/algorithm/string.hpp>
+
+#include "spdlog/spdlog.h"
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <pthread.h>
+	#include <sched.h>
+	#include <sys/resource.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+
+Executor::Executor(const std::string &lane_name, const int &lane_threads, const int &lane_priority, const int &lane_scheduler)
+{
+	name = lane_name;
+	threads_count = lane_threads;
+	priority = lane_priority;
+	scheduler = lane_scheduler;
+}
+
+
+Executor::~Executor(void)
+{
+	stop();
+}
+
+
+int Executor::getPriority(const std::string &priority_str)
+{
+	if (boost::algorithm::iequals(priority_str, "Lowest"))
+	{
+		return LOWEST;
+	}
+	else if (boost::algorithm::iequals(priority_str, "Low"))
+	{
+		return LOW;
+	}
+	else if (boost::algorithm::iequals(priority_str, "High"))
+	{
+		return HIGH;
+	}
+	else if (boost::algorithm::iequals(priority_str, "Highest"))
+	{
+		return HIGHEST;
+	}
+	return NORMAL;
+}
+
+
+std::vector<int> Executor::getAffinity(const std::string &affinity_str)
+{
+	std::vector<int> cpu_affinity;
+	std::vector<std::string> tokens;
+	boost::split(tokens, affinity_str, boost::is_any_of(","));
+	for (auto &token : tokens)
+	{
+		boost::algorithm::trim(token);
+		if (token.empty())
+		{
+			continue;
+		}
+		try
+		{
+			const std::size_t found = token.find('-');
+			const int first = std::stoi(token.substr(0, found));
+			const int last = (found == std::string::npos) ? first : std::stoi(token.substr(found + 1));
+			for (int core = std::max(first, 0); core <= last; ++core)
+			{
+				cpu_affinity.push_back(core);
+			}
+		}
+		catch (std::exception const &)
+		{
+			auto logger = spdlog::get("extDB3 File Logger");
+			if (logger)
+			{
+				logger->warn("extDB3: Invalid CPU Affinity: {0}", token);
+			}
+		}
+	}
+	std::sort(cpu_affinity.begin(), cpu_affinity.end());
+	cpu_affinity.erase(std::unique(cpu_affinity.begin(), cpu_affinity.end()), cpu_affinity.end());
+	return cpu_affinity;
+}
+
+
+std::string Executor::affinityToString(const std::vector<int> &cpu_affinity)
+{
+	if (cpu_affinity.empty())
+	{
+		return "All";
+	}
+	std::string result;
+	for (auto &core : cpu_affinity)
+	{
+		if (!result.empty())
+		{
+			result += ",";
+		}
+		result += std::to_string(core);
+	}
+	return result;
+}
+
+
+bool Executor::setThreadAffinity(const std::vector<int> &cpu_affinity)
+// Pins calling Thread, Cores beyond the OS Limit (64 on Windows without Processor Groups) are ignored
+{
+	if (cpu_affinity.empty())
+	{
+		return true;
+	}
+	#ifdef _WIN32
+		DWORD_PTR mask = 0;
+		for (auto &core : cpu_affinity)
+		{
+			if (core < static_cast<int>(sizeof(DWORD_PTR) * 8))
+			{
+				mask |= (static_cast<DWORD_PTR>(1) << core);
+			}
+		}
+		return ((mask != 0) && (SetThreadAffinityMask(GetCurrentThread(), mask) != 0));
+	#else
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		for (auto &core : cpu_affinity)
+		{
+			if (core < CPU_SETSIZE)
+			{
+				CPU_SET(core, &cpu_set);
+			}
+		}
+		return ((CPU_COUNT(&cpu_set) > 0) && (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0));
+	#endif
+}
+
+
+int Executor::getCurrentCore()
+// Core the calling Thread is running on right now, a Thread already pinned to a single Core always reports it
+{
+	#ifdef _WIN32
+		return static_cast<int>(GetCurrentProcessorNumber());
+	#else
+		return sched_getcpu();
+	#endif
+}
+
+
+void Executor::setAffinity(const std::vector<int> &lane_cpu_affinity)
+{
+	cpu_affinity = lane_cpu_affinity;
+}
+
+
+int Executor::getScheduler(const std::string &scheduler_str)
+{
+	if (boost::algorithm::iequals(scheduler_str, "ASIO"))
+	{
+		return ASIO;
+	}
+	return WORK_STEALING;
+}
+
+
+int Executor::getOverflowPolicy(const std::string &policy_str)
+{
+	if (boost::algorithm::iequals(policy_str, "Block"))
+	{
+		return BLOCK;
+	}
+	else if (boost::algorithm::iequals(policy_str, "Drop"))
+	{
+		return DROP;
+	}
+	return REJECT;
+}
+
+
+void Executor::setQueue(const queue_options &options)
+{
+	oneway_queue_options = options;
+	oneway_queue.reset(new BoundedQueue<std::function<void()>>(std::max(options.size, std::size_t(2))));
+	high_watermark = (oneway_queue->capacity() * std::min(std::max(options.high_watermark, 1), 100)) / 100;
+	low_watermark = (oneway_queue->capacity() * std::min(std::max(options.low_watermark, 0), options.high_watermark)) / 100;
+}
+
+
+bool Executor::enqueue(std::function<void()> &&handler)
+// Drain Tasks scheduled >= Queued calls, so stop() only returns once the queue is empty
+//   Capped at Queue Capacity, calls dropped by DROP policy leave their Drain Task behind without growing the Scheduler backlog
+{
+	if (oneway_queue->enqueue(std::move(handler)))
+	{
+		if (drains_scheduled.fetch_add(1, std::memory_order_acq_rel) < oneway_queue->capacity())
+		{
+			post(boost::bind(&Executor::drain, this));
+		}
+		else
+		{
+			drains_scheduled.fetch_sub(1, std::memory_order_acq_rel);
+		}
+		return true;
+	}
+	return false;
+}
+
+
+void Executor::drain()
+// Counter is only decremented after dequeue, so a queued call is never left without a Drain Task
+{
+	std::function<void()> handler;
+	const bool found = oneway_queue->dequeue(handler);
+	drains_scheduled.fetch_sub(1, std::memory_order_acq_rel);
+	if (found)
+	{
+		handler();
+	}
+}
+
+
+bool Executor::submit(std::function<void()> &&handler)
+// One-Way Call, returns false if rejected
+{
+	if (!oneway_queue)
+	{
+		post(std::move(handler));
+		return true;
+	}
+
+	const std::size_t depth = oneway_queue->size();
+	if (backpressure.load(std::memory_order_relaxed))
+	{
+		if (depth <= low_watermark)
+		{
+			backpressure.store(false, std::memory_order_relaxed);
+		}
+	}
+	else if (depth >= high_watermark)
+	{
+		backpressure.store(true, std::memory_order_relaxed);
+		auto logger = spdlog::get("extDB3 File Logger");
+		if (logger)
+		{
+			logger->warn("extDB3: Lane: {0}, Queue High Watermark Reached: {1}", name, depth);
+		}
+	}
+
+	// DROP never turns a call away while the Queue has room, Watermarks only gate REJECT / BLOCK
+	if (((!backpressure.load(std::memory_order_relaxed)) || (oneway_queue_options.overflow_policy == DROP)) && (enqueue(std::move(handler))))
+	{
+		return true;
+	}
+
+	switch (oneway_queue_options.overflow_policy)
+	{
+		case BLOCK:
+		{
+			// Game Thread waits briefly for Workers to catch up
+			const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(oneway_queue_options.block_timeout);
+			while (std::chrono::steady_clock::now() < deadline)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				if (oneway_queue->size() <= low_watermark)
+				{
+					backpressure.store(false, std::memory_order_relaxed);
+					break;
+				}
+			}
+			if (enqueue(std::move(handler)))
+			{
+				return true;
+			}
+			break;
+		}
+		case DROP:
+		{
+			// Queue Full, drop oldest queued call to make room. One-Way Calls carry no priority, so age is the only order
+			std::function<void()> oldest;
+			for (int i = 0; i < 4; ++i)
+			{
+				if (oneway_queue->dequeue(oldest))
+				{
+					dropped.fetch_add(1, std::memory_order_relaxed);
+				}
+				if (enqueue(std::move(handler)))
+				{
+					return true;
+				}
+			}
+			break;
+		}
+	}
+	rejected.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+
+std::size_t Executor::getQueueDepth()
+{
+	return oneway_queue ? oneway_queue->size() : 0;
+}
+
+
+std::size_t Executor::getQueueCapacity()
+{
+	return oneway_queue ? oneway_queue->capacity() : 0;
+}
+
+
+std::size_t Executor::getQueueRejected()
+{
+	return rejected.load(std::memory_order_relaxed);
+}
+
+
+std::size_t Executor::getQueueDropped()
+{
+	return dropped.load(std::memory_order_relaxed);
+}
+
+
+void Executor::start()
+{
+	if (scheduler == WORK_STEALING)
+	{
+		work_stealing.start(threads_count, std::max(max_threads, threads_count), boost::bind(&Executor::initThread, this));
+	}
+	else
+	{
+		io_service.reset();
+		io_work_ptr.reset(new boost::asio::io_service::work(io_service));
+		for (int i = 0; i < threads_count; ++i)
+		{
+			threads.create_thread(boost::bind(&Executor::run, this));
+		}
+	}
+}
+
+
+void Executor::stop()
+// Queued tasks are run before Worker Threads exit
+{
+	work_stealing.stop();
+	io_work_ptr.reset(nullptr);
+	threads.join_all();
+	io_service.stop();
+}
+
+
+void Executor::run()
+// ASIO Worker Thread
+{
+	initThread();
+	io_service.run();
+}
+
+
+void Executor::initThread()
+{
+	MetricsBlockedScope::counter = &blocked_time;
+	if ((priority != NORMAL) && (!setThreadPriority()))
+	{
+		auto logger = spdlog::get("extDB3 File Logger");
+		if (logger)
+		{
+			logger->warn("extDB3: Lane: {0}, Failed to set Thread Priority: {1}", name, priority);
+		}
+	}
+	if (!setThreadAffinity(cpu_affinity))
+	{
+		auto logger = spdlog::get("extDB3 File Logger");
+		if (logger)
+		{
+			logger->warn("extDB3: Lane: {0}, Failed to set CPU Affinity: {1}", name, affinityToString(cpu_affinity));
+		}
+	}
+}
+
+
+void Executor::setAdaptive(const int &lane_min_threads, const int &lane_max_threads, const int &lane_target_latency)
+{
+	min_threads = std::max(lane_min_threads, 1);
+	max_threads = std::max(lane_max_threads, min_threads);
+	target_latency = std::max(lane_target_latency, 1);
+	threads_count = std::min(std::max(threads_count, min_threads), max_threads);
+}
+
+
+bool Executor::isAdaptive() const
+{
+	return ((scheduler == WORK_STEALING) && (min_threads < max_threads));
+}
+
+
+int Executor::getThreads() const
+{
+	return (scheduler == WORK_STEALING) ? work_stealing.getThreads() : threads_count;
+}
+
+
+void Executor::adjust(const int &interval_ms)
+// Queue Latency high + Workers mostly blocked on Database = more Threads help, CPU bound Workers are only grown up to Core Count
+//   Shrinks 1 Thread after 5 idle intervals
+{
+	const std::uint64_t latency_count = queue_latency.getCount();
+	const std::uint64_t latency_sum = queue_latency.getSum();
+	const std::uint64_t blocked = blocked_time.load(std::memory_order_relaxed);
+	const std::uint64_t average_latency = (latency_count > prev_latency_count) ? ((latency_sum - prev_latency_sum) / (latency_count - prev_latency_count)) : 0;
+	const int threads = std::max(getThreads(), 1);
+	blocked_percent = static_cast<int>(((blocked - prev_blocked_time) * 100) / (static_cast<std::uint64_t>(interval_ms) * 1000 * threads));
+	prev_latency_count = latency_count;
+	prev_latency_sum = latency_sum;
+	prev_blocked_time = blocked;
+
+	if (!isAdaptive())
+	{
+		return;
+	}
+
+	const std::size_t backlog = pending.load(std::memory_order_relaxed);
+	const std::uint64_t target = static_cast<std::uint64_t>(target_latency) * 1000;
+	int new_threads = threads;
+	if (((average_latency > target) || (backlog > static_cast<std::size_t>(threads))) && (threads < max_threads) &&
+		((blocked_percent >= 50) || (threads < static_cast<int>(boost::thread::hardware_concurrency()))))
+	{
+		new_threads = std::min(threads + std::max(threads / 4, 1), max_threads);
+		idle_intervals = 0;
+	}
+	else if ((average_latency < (target / 4)) && (backlog == 0) && (threads > min_threads))
+	{
+		if (++idle_intervals >= 5)
+		{
+			new_threads = threads - 1;
+			idle_intervals = 0;
+		}
+	}
+	else
+	{
+		idle_intervals = 0;
+	}
+
+	if (new_threads != threads)
+	{
+		work_stealing.resize(new_threads);
+		auto logger = spdlog::get("extDB3 File Logger");
+		if (logger)
+		{
+			logger->info("extDB3: Lane: {0}, Worker Threads: {1} -> {2}, Queue Latency: {3}us, Backlog: {4}, Blocked: {5}%", name, threads, new_threads, average_latency, backlog, blocked_percent.load());
+		}
+	}
+}
+
+
+bool Executor::setThreadPriority()
+// Raising Priority on Linux requires CAP_SYS_NICE, Thread keeps default priority on failure
+{
+	#ifdef _WIN32
+		int thread_priority = THREAD_PRIORITY_NORMAL;
+		switch (priority)
+		{
+			case LOWEST:
+				thread_priority = THREAD_PRIORITY_LOWEST;
+				break;
+			case LOW:
+				thread_priority = THREAD_PRIORITY_BELOW_NORMAL;
+				break;
+			case HIGH:
+				thread_priority = THREAD_PRIORITY_ABOVE_NORMAL;
+				break;
+			case HIGHEST:
+				thread_priority = THREAD_PRIORITY_HIGHEST;
+				break;
+		}
+		return (SetThreadPriority(GetCurrentThread(), thread_priority) != 0);
+	#else
+		// Linux Nice Value is per Thread when using Thread ID
+		const int nice_value = priority * -5;
+		return (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice_value) == 0);
+	#endif
+}
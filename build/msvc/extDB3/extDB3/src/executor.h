@@ -0,0 +1,141 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "bounded_queue.h"
+#include "metrics.h"
+#include "scheduler.h"
+
+
+class Executor
+// Execution Lane -- Own Task Queue + Worker Threads
+//   Protocols are assigned to a Lane via [Lane <Name>] in extdb3-conf.ini, so bulk work never queues ahead of time critical calls
+//   Tasks run on a Work-Stealing Scheduler (default) or a shared ASIO io_service queue
+{
+public:
+	Executor(const std::string &lane_name, const int &lane_threads, const int &lane_priority, const int &lane_scheduler);
+	~Executor();
+
+	enum Scheduler { ASIO, WORK_STEALING };
+	static int getScheduler(const std::string &scheduler_str);
+
+	// Thread Priority, mapped to OS Thread Priority / Nice Value
+	enum Priority { LOWEST = -2, LOW = -1, NORMAL = 0, HIGH = 1, HIGHEST = 2 };
+	static int getPriority(const std::string &priority_str);
+
+	// CPU Affinity, list of Core Indexes i.e "2-5,7", empty = All Cores
+	static std::vector<int> getAffinity(const std::string &affinity_str);
+	static std::string affinityToString(const std::vector<int> &cpu_affinity);
+	static bool setThreadAffinity(const std::vector<int> &cpu_affinity);
+	static int getCurrentCore();  // -1 if unknown
+	void setAffinity(const std::vector<int> &lane_cpu_affinity);
+
+	// One-Way Call Admission Queue
+	//   Above High Watermark the Overflow Policy applies, until depth falls below Low Watermark
+	enum OverflowPolicy { REJECT, BLOCK, DROP };
+	struct queue_options
+	{
+		std::size_t size = 65536;
+		int high_watermark = 90;  // % of Size
+		int low_watermark = 50;   // % of Size
+		int overflow_policy = REJECT;
+		int block_timeout = 50;   // Milliseconds
+	};
+	static int getOverflowPolicy(const std::string &policy_str);
+	void setQueue(const queue_options &options);
+	bool submit(std::function<void()> &&handler);
+
+	std::size_t getQueueDepth();
+	std::size_t getQueueCapacity();
+	std::size_t getQueueRejected();
+	std::size_t getQueueDropped();
+
+	void start();
+	void stop();
+
+	// Adaptive Worker Pool (Work-Stealing only), called periodically from Timer Thread
+	//   Grows when Queue Latency > Target + Workers are blocked on Database, shrinks when idle
+	void setAdaptive(const int &lane_min_threads, const int &lane_max_threads, const int &lane_target_latency);
+	bool isAdaptive() const;
+	void adjust(const int &interval_ms);
+	int getThreads() const;
+
+	template <typename Handler>
+	void post(Handler &&handler)
+	{
+		pending.fetch_add(1, std::memory_order_relaxed);
+		const auto start = std::chrono::steady_clock::now();
+		auto task = [this, start, handler = std::forward<Handler>(handler)]() mutable
+		{
+			pending.fetch_sub(1, std::memory_order_relaxed);
+			queue_latency.record(start);
+			handler();
+		};
+		if (scheduler == WORK_STEALING)
+		{
+			work_stealing.post(std::move(task));
+		}
+		else
+		{
+			io_service.post(std::move(task));
+		}
+	}
+
+	std::string name;
+	int threads_count;
+	int priority;
+	int scheduler;
+	std::vector<int> cpu_affinity;
+
+	// Metrics
+	std::atomic<std::size_t> pending{0};  // Tasks waiting for a Worker Thread
+	MetricsHistogram queue_latency;        // Post -> Worker Thread start
+	std::atomic<std::uint64_t> blocked_time{0};  // Microseconds Workers spent blocked on Database
+	std::atomic<int> blocked_percent{0};         // Last adjust interval
+
+private:
+	// ASIO
+	boost::asio::io_service io_service;
+	std::unique_ptr<boost::asio::io_service::work> io_work_ptr;
+	boost::thread_group threads;
+
+	// Work-Stealing
+	WorkStealingScheduler work_stealing;
+
+	// Adaptive
+	int min_threads = 0;
+	int max_threads = 0;
+	int target_latency = 10;  // Milliseconds
+	int idle_intervals = 0;
+	std::uint64_t prev_latency_count = 0;
+	std::uint64_t prev_latency_sum = 0;
+	std::uint64_t prev_blocked_time = 0;
+
+	std::unique_ptr<BoundedQueue<std::function<void()>>> oneway_queue;
+	queue_options oneway_queue_options;
+	std::size_t high_watermark = 0;
+	std::size_t low_watermark = 0;
+	std::atomic<bool> backpressure{false};
+	std::atomic<std::size_t> rejected{0};
+	std::atomic<std::size_t> dropped{0};
+	std::atomic<std::size_t> drains_scheduled{0};  // Drain Tasks not finished yet, never above Queue Capacity
+
+	void run();
+	void initThread();
+	void drain();
+	bool enqueue(std::function<void()> &&handler);
+	bool setThreadPriority();
+};
@@ -5,12 +5,15 @@
 
 #include "ext.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <limits>
 #include <mutex>
 #include <regex>
 #include <stdlib.h>
+#include <string_view>
 #include <thread>
 
 #include <boost/algorithm/string.hpp>
@@ -36,9 +39,62 @@
 
 #pragma warning(disable : 4996)
 
+
+inline std::string getArg(const char *arg)
+// RVExtensionArgs: Arma passes Strings wrapped in quotes, with any quotes inside doubled
+{
+	std::size_t len = std::strlen(arg);
+	if ((len >= 2) && (arg[0] == '"') && (arg[len - 1] == '"'))
+	{
+		std::string token;
+		token.reserve(len - 2);
+		for (std::size_t pos = 1; pos < (len - 1); ++pos)
+		{
+			token += arg[pos];
+			if ((arg[pos] == '"') && (arg[pos + 1] == '"'))
+			{
+				++pos;
+			}
+		}
+		return token;
+	}
+	return std::string(arg, len);
+}
+
+
+inline std::string_view getArgView(const char *arg)
+// RVExtensionArgs: Strips surrounding quotes only, for Protocol Names / Unique IDs that never contain quotes
+{
+	std::string_view token(arg);
+	if ((token.size() >= 2) && (token.front() == '"') && (token.back() == '"'))
+	{
+		token.remove_prefix(1);
+		token.remove_suffix(1);
+	}
+	return token;
+}
+
+
+inline std::size_t splitTokens(std::string_view input_str, std::string_view *tokens, const std::size_t max_tokens)
+// Splits on ':' without copying, returns max_tokens + 1 if input has more Tokens
+{
+	std::size_t count = 0;
+	while (count < max_tokens)
+	{
+		const std::string_view::size_type found = input_str.find(':');
+		tokens[count++] = input_str.substr(0, found);
+		if (found == std::string_view::npos)
+		{
+			return count;
+		}
+		input_str.remove_prefix(found + 1);
+	}
+	return max_tokens + 1;
+}
+
+
 Ext::Ext(std::string shared_library_path)
 {
-	uptime_start = std::chrono::steady_clock::now();
 	std::setlocale(LC_ALL, "");
 	std::locale::global(std::locale(""));
 	std::setlocale(LC_NUMERIC, "C");
@@ -75,6 +131,26 @@ Ext::Ext(std::string shared_library_path)
 			boost::property_tree::ini_parser::read_ini(config_path.string(), ptree);
 			ext_info.logger_flush = ptree.get("Log.Flush",true);
 
+			// CPU Affinity -- Ext is created on the first callExtension, so calling Thread is the Game Thread
+			ext_info.game_core = Executor::getCurrentCore();
+			ext_info.cpu_affinity = Executor::getAffinity(ptree.get("Main.CPU Affinity", std::string("")));
+			if ((ptree.get("Main.Exclude Game Core", false)) && (ext_info.game_core >= 0))
+			{
+				if (ext_info.cpu_affinity.empty())
+				{
+					for (int core = 0; core < static_cast<int>(boost::thread::hardware_concurrency()); ++core)
+					{
+						ext_info.cpu_affinity.push_back(core);
+					}
+				}
+				ext_info.cpu_affinity.erase(std::remove(ext_info.cpu_affinity.begin(), ext_info.cpu_affinity.end(), ext_info.game_core), ext_info.cpu_affinity.end());
+			}
+			ext_info.log_cpu_affinity = Executor::getAffinity(ptree.get("Log.CPU Affinity", std::string("")));
+			if (ext_info.log_cpu_affinity.empty())
+			{
+				ext_info.log_cpu_affinity = ext_info.cpu_affinity;
+			}
+
 			// Search for Randomize Config File -- Legacy Security Support For Arma2Servers
 
 			if ((ptree.get("Main.Randomize Config File",false)) && (!conf_randomized))
@@ -99,9 +175,15 @@ Ext::Ext(std::string shared_library_path)
 		}
 
 		// Initialize Loggers
+		//		Async Mode, each Logger gets its own Thread pinned to Log CPU Affinity
+		if (ptree.get("Log.Async", false))
+		{
+			size_t q_size = 1048576; //queue size must be power of 2
+			const std::vector<int> log_cpu_affinity = ext_info.log_cpu_affinity;
+			spdlog::set_async_mode(q_size, spdlog::async_overflow_policy::block_retry, [log_cpu_affinity]() { Executor::setThreadAffinity(log_cpu_affinity); });
+		}
+
 		//		Console Logger
-		//size_t q_size = 1048576; //queue size must be power of 2
-		//spdlog::set_async_mode(q_size);
 
 		#ifdef DEBUG_TESTING
 			spdlog::drop("extDB3 Console logger");
@@ -129,6 +211,14 @@ Ext::Ext(std::string shared_library_path)
 
 		spdlog::drop("extDB3 File logger");
 		logger = spdlog::rotating_logger_mt("extDB3 File Logger", log_relative_path.make_preferred().string(), 1048576 * 100, 3);
+
+		//		Metrics Logger
+		metrics_dump_interval = ptree.get("Metrics.Dump Interval", 0);
+		if (metrics_dump_interval > 0)
+		{
+			spdlog::drop("extDB3 Metrics Logger");
+			metrics_logger = spdlog::rotating_logger_mt("extDB3 Metrics Logger", log_relative_path.make_preferred().string() + "-metrics", 1048576 * 10, 3);
+		}
 		
 		if (ext_info.logger_flush)
 			logger->flush_on(spdlog::level::info);
@@ -164,6 +254,7 @@ Ext::Ext(std::string shared_library_path)
 			console->info("This is used for poor man stress testing");
 			console->info("");
 			console->info("Type 'test' for spam test");
+			console->info("Type 'bench' for worker pool benchmark (ASIO vs Work Stealing)");
 			console->info("Type 'quit' to exit");
 		#else
 			logger->info("Message: All development for extDB3 is done on a Linux Dedicated Server");
@@ -256,12 +347,40 @@ Ext::Ext(std::string shared_library_path)
 				logger->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads (config settings)", detected_cpu_cores, ext_info.max_threads);
 			}
 
-			// Setup ASIO Worker Pool
-			io_work_ptr.reset(new boost::asio::io_service::work(io_service));
-			for (int i = 0; i < ext_info.max_threads; ++i)
+			#ifdef DEBUG_TESTING
+				console->info("extDB3: Game Thread Core: {0}, Worker CPU Affinity: {1}, Log CPU Affinity: {2}", ext_info.game_core, Executor::affinityToString(ext_info.cpu_affinity), Executor::affinityToString(ext_info.log_cpu_affinity));
+			#endif
+			logger->info("extDB3: Game Thread Core: {0}, Worker CPU Affinity: {1}, Log CPU Affinity: {2}", ext_info.game_core, Executor::affinityToString(ext_info.cpu_affinity), Executor::affinityToString(ext_info.log_cpu_affinity));
+
+			// Setup Worker Pools
+			setupLanes();
+
+			// Stored Results Limits
+			const int result_ttl = ptree.get("Main.Result TTL", 600);
+			const int result_memory_limit = ptree.get("Main.Result Memory Limit", 256);
+			const int stream_ttl = ptree.get("Main.Stream TTL", 60);
+			// MB -> Bytes, capped so x86 builds can't overflow size_t
+			const std::size_t result_memory_limit_mb = std::min(static_cast<std::size_t>(std::max(result_memory_limit, 0)), (std::numeric_limits<std::size_t>::max() / 1048576));
+			stored_results.setLimits(std::chrono::seconds(std::max(result_ttl, 0)), (result_memory_limit_mb * 1048576), std::chrono::seconds(std::max(stream_ttl, 0)));
+			if ((result_ttl > 0) || (stream_ttl > 0))
+			{
+				result_cleanup_interval = 60;
+				if (result_ttl > 0)
+				{
+					result_cleanup_interval = std::min(result_ttl, result_cleanup_interval);
+				}
+				if (stream_ttl > 0)
+				{
+					result_cleanup_interval = std::min(stream_ttl, result_cleanup_interval);
+				}
+				startResultCleanup();
+			}
+			logger->info("extDB3: Result TTL: {0}s, Result Memory Limit: {1}MB, Stream TTL: {2}s", result_ttl, result_memory_limit_mb, stream_ttl);
+
+			if (metrics_dump_interval > 0)
 			{
-				logger->info("extDB3: ...");
-				threads.create_thread(boost::bind(&boost::asio::io_service::run, &io_service));
+				startMetricsDump();
+				logger->info("extDB3: Metrics Dump Interval: {0}s", metrics_dump_interval);
 			}
 
 			logger->info("");
@@ -299,6 +418,7 @@ Ext::~Ext(void)
 	#endif
 	logger->info("extDB3: Closing ...");
 	stop();
+	stored_results.eraseStreams();
 	mysql_library_end();
 	spdlog::drop_all();
 }
@@ -307,22 +427,40 @@ Ext::~Ext(void)
 void Ext::reset()
 {
 	stop();
-	std::lock_guard<std::mutex> lock(mutex_vec_protocols);
+	const std::size_t erased_streams = stored_results.eraseStreams();
+	if (erased_streams > 0)
+	{
+		logger->info("extDB3: Reset: Discarded {0} Streaming Results", erased_streams);
+	}
+	std::lock_guard<std::mutex> lock(mutex_protocols_registry);
+	{
+		// Safe to free old snapshots, worker threads are stopped
+		protocols_registry.store(nullptr, std::memory_order_release);
+		protocols_registry_snapshots.clear();
+	}
+	std::lock_guard<std::mutex> lock_databases(mutex_mariadb_databases);
 	{
-		vec_protocols.clear();
+		mariadb_databases.clear();
 	}
-	mariadb_databases.clear();
 
-	// Setup ASIO Worker Pool
-	io_service.reset();
-	io_work_ptr.reset(new boost::asio::io_service::work(io_service));
-	for (int i = 0; i < ext_info.max_threads; ++i)
+	// Setup Worker Pools
+	for (auto &lane : lanes)
 	{
-		threads.create_thread(boost::bind(&boost::asio::io_service::run, &io_service));
+		lane.second->start();
 	}
-	mariadb_idle_cleanup_timer.reset(new boost::asio::deadline_timer(io_service));
-	mariadb_idle_cleanup_timer->expires_at(mariadb_idle_cleanup_timer->expires_at() + boost::posix_time::seconds(600));
+	startTimerService();
+	startLanesAdjust();
+	mariadb_idle_cleanup_timer.reset(new boost::asio::deadline_timer(timer_service));
+	mariadb_idle_cleanup_timer->expires_from_now(boost::posix_time::seconds(60));
 	mariadb_idle_cleanup_timer->async_wait(boost::bind(&Ext::idleCleanup, this, _1));
+	if (result_cleanup_interval > 0)
+	{
+		startResultCleanup();
+	}
+	if (metrics_dump_interval > 0)
+	{
+		startMetricsDump();
+	}
 }
 
 
@@ -336,29 +474,410 @@ void Ext::stop()
 			mariadb_idle_cleanup_timer.reset(nullptr);
 		}
 	}
-	io_work_ptr.reset(nullptr);
-	threads.join_all();
-	io_service.stop();
+	std::lock_guard<std::mutex> lock_results(mutex_result_cleanup_timer);
+	{
+		if (result_cleanup_timer)
+		{
+			result_cleanup_timer->cancel();
+			result_cleanup_timer.reset(nullptr);
+		}
+	}
+	std::lock_guard<std::mutex> lock_metrics(mutex_metrics_dump_timer);
+	{
+		if (metrics_dump_timer)
+		{
+			metrics_dump_timer->cancel();
+			metrics_dump_timer.reset(nullptr);
+		}
+	}
+	std::lock_guard<std::mutex> lock_lanes(mutex_lanes_adjust_timer);
+	{
+		if (lanes_adjust_timer)
+		{
+			lanes_adjust_timer->cancel();
+			lanes_adjust_timer.reset(nullptr);
+		}
+	}
+	std::lock_guard<std::mutex> lock_push_retry(mutex_push_retry);
+	{
+		if (push_retry_timer)
+		{
+			push_retry_timer->cancel();
+			push_retry_timer.reset(nullptr);
+		}
+		push_retry_armed = false;
+	}
+	timer_work_ptr.reset(nullptr);
+	timer_service.stop();
+	if (timer_thread.joinable())
+	{
+		timer_thread.join();
+	}
+	for (auto &lane : lanes)
+	{
+		lane.second->stop();
+	}
 }
 
 
 void Ext::idleCleanup(const boost::system::error_code& ec)
+// Database Health Check + Idle Trimming, every 60 seconds
+//   Pings + Reconnects are posted to Default Lane, Timer Thread is shared with resultCleanup / lanesAdjust / metricsDump
 {
 	if (!ec)
 	{
-		for(auto &dbpool : mariadb_databases)
+		if (!mariadb_idle_cleanup_running.exchange(true))
 		{
-				dbpool.second.idleCleanup();
+			// Snapshot Pools, slow pings must not hold up connectDatabase / 9:METRICS
+			std::vector<MariaDBPool *> database_pools;
+			{
+				std::lock_guard<std::mutex> lock(mutex_mariadb_databases);
+				for (auto &dbpool : mariadb_databases)
+				{
+					database_pools.push_back(&dbpool.second);
+				}
+			}
+			// Pools are only erased after stop(), which drains Default Lane
+			default_lane->post([this, database_pools = std::move(database_pools)]()
+			{
+				for (auto &database_pool : database_pools)
+				{
+					database_pool->idleCleanup();
+				}
+				mariadb_idle_cleanup_running.store(false);
+			});
 		}
 		std::lock_guard<std::mutex> lock(mutex_mariadb_idle_cleanup_timer);
+		if (mariadb_idle_cleanup_timer)
 		{
-			mariadb_idle_cleanup_timer->expires_at(mariadb_idle_cleanup_timer->expires_at() + boost::posix_time::seconds(300));
+			mariadb_idle_cleanup_timer->expires_at(mariadb_idle_cleanup_timer->expires_at() + boost::posix_time::seconds(60));
 			mariadb_idle_cleanup_timer->async_wait(boost::bind(&Ext::idleCleanup, this, _1));
 		}
 	}
 }
 
 
+void Ext::startResultCleanup()
+{
+	std::lock_guard<std::mutex> lock(mutex_result_cleanup_timer);
+	{
+		result_cleanup_timer.reset(new boost::asio::deadline_timer(timer_service));
+		result_cleanup_timer->expires_from_now(boost::posix_time::seconds(result_cleanup_interval));
+		result_cleanup_timer->async_wait(boost::bind(&Ext::resultCleanup, this, _1));
+	}
+}
+
+
+void Ext::resultCleanup(const boost::system::error_code& ec)
+// Evicts Stored Results nobody fetched within Result TTL i.e Player disconnected mid-query
+{
+	if (!ec)
+	{
+		std::vector<std::unique_ptr<ResultStream>> expired_streams;
+		stored_results.sweep(expired_streams);
+		for (auto &stream : expired_streams)
+		{
+			// Freeing a Stream reads its unread rows from the Server, done on its Lane so Timer Thread never stalls
+			Executor *lane = stream->lane;
+			lane->post([stream_ptr = std::shared_ptr<ResultStream>(std::move(stream))]() mutable { stream_ptr.reset(); });
+		}
+		std::lock_guard<std::mutex> lock(mutex_result_cleanup_timer);
+		{
+			if (result_cleanup_timer)
+			{
+				result_cleanup_timer->expires_at(result_cleanup_timer->expires_at() + boost::posix_time::seconds(result_cleanup_interval));
+				result_cleanup_timer->async_wait(boost::bind(&Ext::resultCleanup, this, _1));
+			}
+		}
+	}
+}
+
+
+void Ext::setupLanes()
+// Default Lane = Main.Threads
+// [Lane <Name>]
+//   Threads = Number of Worker Threads
+//   Priority = Lowest / Low / Normal / High / Highest
+//   Protocols = Protocol Names (ADD_PROTOCOL name), comma seperated
+//   Queue Size + Overflow Policy, overrides [Queue] for this Lane
+{
+	const int scheduler = Executor::getScheduler(ptree.get("Main.Scheduler", std::string("Work Stealing")));
+
+	// One-Way Call Admission Queue
+	Executor::queue_options queue_options;
+	queue_options.size = ptree.get("Queue.Size", 65536);
+	queue_options.high_watermark = ptree.get("Queue.High Watermark", 90);
+	queue_options.low_watermark = ptree.get("Queue.Low Watermark", 50);
+	queue_options.overflow_policy = Executor::getOverflowPolicy(ptree.get("Queue.Overflow Policy", std::string("Reject")));
+	queue_options.block_timeout = ptree.get("Queue.Block Timeout", 50);
+
+	// Adaptive Worker Pool
+	const int target_latency = ptree.get("Main.Target Queue Latency", 10);
+
+	lanes["Default"].reset(new Executor("Default", ext_info.max_threads, Executor::NORMAL, scheduler));
+	default_lane = lanes["Default"].get();
+	default_lane->setQueue(queue_options);
+	default_lane->setAffinity(ext_info.cpu_affinity);
+	int min_threads = ptree.get("Main.Min Threads", 0);
+	int max_threads = ptree.get("Main.Max Threads", 0);
+	default_lane->setAdaptive(((min_threads > 0) ? min_threads : ext_info.max_threads), ((max_threads > 0) ? max_threads : ext_info.max_threads), target_latency);
+
+	for (auto &section : ptree)
+	{
+		if (!boost::algorithm::istarts_with(section.first, "Lane "))
+		{
+			continue;
+		}
+		const std::string lane_name = boost::algorithm::trim_copy(section.first.substr(5));
+		if ((lane_name.empty()) || (lanes.count(lane_name) > 0))
+		{
+			logger->warn("extDB3: Invalid Lane Name: {0}", section.first);
+			continue;
+		}
+		const int lane_threads = std::max(section.second.get("Threads", 1), 1);
+		const int lane_priority = Executor::getPriority(section.second.get("Priority", std::string("Normal")));
+		const int lane_scheduler = Executor::getScheduler(section.second.get("Scheduler", ptree.get("Main.Scheduler", std::string("Work Stealing"))));
+		Executor *lane = new Executor(lane_name, lane_threads, lane_priority, lane_scheduler);
+		lanes[lane_name].reset(lane);
+
+		Executor::queue_options lane_queue_options = queue_options;
+		lane_queue_options.size = section.second.get("Queue Size", queue_options.size);
+		lane_queue_options.overflow_policy = Executor::getOverflowPolicy(section.second.get("Overflow Policy", ptree.get("Queue.Overflow Policy", std::string("Reject"))));
+		lane->setQueue(lane_queue_options);
+		const std::vector<int> lane_cpu_affinity = Executor::getAffinity(section.second.get("CPU Affinity", std::string("")));
+		lane->setAffinity(lane_cpu_affinity.empty() ? ext_info.cpu_affinity : lane_cpu_affinity);
+		min_threads = section.second.get("Min Threads", 0);
+		max_threads = section.second.get("Max Threads", 0);
+		lane->setAdaptive(((min_threads > 0) ? min_threads : lane_threads), ((max_threads > 0) ? max_threads : lane_threads), target_latency);
+
+		std::vector<std::string> protocol_names;
+		boost::split(protocol_names, section.second.get("Protocols", std::string("")), boost::is_any_of(","));
+		for (auto &protocol_name : protocol_names)
+		{
+			boost::algorithm::trim(protocol_name);
+			if (!protocol_name.empty())
+			{
+				lanes_protocols[protocol_name] = lane;
+			}
+		}
+		#ifdef DEBUG_TESTING
+			console->info("extDB3: Lane: {0}, Threads: {1}, Priority: {2}, CPU Affinity: {3}, Protocols: {4}", lane_name, lane_threads, lane_priority, Executor::affinityToString(lane->cpu_affinity), section.second.get("Protocols", std::string("")));
+		#endif
+		logger->info("extDB3: Lane: {0}, Threads: {1}, Priority: {2}, CPU Affinity: {3}, Protocols: {4}", lane_name, lane_threads, lane_priority, Executor::affinityToString(lane->cpu_affinity), section.second.get("Protocols", std::string("")));
+	}
+
+	for (auto &lane : lanes)
+	{
+		lane.second->start();
+		if (lane.second->isAdaptive())
+		{
+			logger->info("extDB3: Lane: {0}, Adaptive Worker Threads, Target Queue Latency: {1}ms", lane.first, target_latency);
+		}
+	}
+	startTimerService();
+	startLanesAdjust();
+}
+
+
+void Ext::startLanesAdjust()
+{
+	std::lock_guard<std::mutex> lock(mutex_lanes_adjust_timer);
+	{
+		lanes_adjust_timer.reset(new boost::asio::deadline_timer(timer_service));
+		lanes_adjust_timer->expires_from_now(boost::posix_time::seconds(1));
+		lanes_adjust_timer->async_wait(boost::bind(&Ext::lanesAdjust, this, _1));
+	}
+}
+
+
+void Ext::lanesAdjust(const boost::system::error_code& ec)
+// Adaptive Worker Pools, runs every second on Timer Thread
+{
+	if (!ec)
+	{
+		for (auto &lane : lanes)
+		{
+			lane.second->adjust(1000);
+		}
+		std::lock_guard<std::mutex> lock(mutex_lanes_adjust_timer);
+		{
+			if (lanes_adjust_timer)
+			{
+				lanes_adjust_timer->expires_at(lanes_adjust_timer->expires_at() + boost::posix_time::seconds(1));
+				lanes_adjust_timer->async_wait(boost::bind(&Ext::lanesAdjust, this, _1));
+			}
+		}
+	}
+}
+
+
+void Ext::startTimerService()
+{
+	timer_service.reset();
+	timer_work_ptr.reset(new boost::asio::io_service::work(timer_service));
+	timer_thread = boost::thread([this]()
+	{
+		if (!Executor::setThreadAffinity(ext_info.log_cpu_affinity))
+		{
+			logger->warn("extDB3: Timer Thread, Failed to set CPU Affinity: {0}", Executor::affinityToString(ext_info.log_cpu_affinity));
+		}
+		timer_service.run();
+	});
+}
+
+
+void Ext::getQueueDepth(char *output, const int &output_size)
+// [1,[["Lane",Depth,Capacity,Rejected,Dropped],...]]
+{
+	std::string result = "[1,[";
+	for (auto &lane : lanes)
+	{
+		if (result.back() != '[')
+		{
+			result += ",";
+		}
+		result += "[\"" + lane.first + "\"," + std::to_string(lane.second->getQueueDepth()) + "," + std::to_string(lane.second->getQueueCapacity()) + "," + std::to_string(lane.second->getQueueRejected()) + "," + std::to_string(lane.second->getQueueDropped()) + "]";
+	}
+	result += "]]";
+	if (result.length() > output_size)
+	{
+		std::strcpy(output, "[0,\"Error Output Size Too Small\"]");
+	}	else {
+		std::strcpy(output, result.c_str());
+	}
+}
+
+
+void Ext::startMetricsDump()
+{
+	std::lock_guard<std::mutex> lock(mutex_metrics_dump_timer);
+	{
+		metrics_dump_timer.reset(new boost::asio::deadline_timer(timer_service));
+		metrics_dump_timer->expires_from_now(boost::posix_time::seconds(metrics_dump_interval));
+		metrics_dump_timer->async_wait(boost::bind(&Ext::metricsDump, this, _1));
+	}
+}
+
+
+void Ext::metricsDump(const boost::system::error_code& ec)
+{
+	if (!ec)
+	{
+		std::string result;
+		getMetrics(result);
+		metrics_logger->info(result);
+		std::lock_guard<std::mutex> lock(mutex_metrics_dump_timer);
+		{
+			if (metrics_dump_timer)
+			{
+				metrics_dump_timer->expires_at(metrics_dump_timer->expires_at() + boost::posix_time::seconds(metrics_dump_interval));
+				metrics_dump_timer->async_wait(boost::bind(&Ext::metricsDump, this, _1));
+			}
+		}
+	}
+}
+
+
+void Ext::getMetrics(std::string &result)
+// [1,[
+//   ["CALLS",[Mode 0,...,Mode 9]],
+//   ["LANES",[["Lane",Threads,Blocked %,Pending,Queue Depth,[Queue Latency]],...]],
+//   ["PROTOCOLS",[["Protocol",[Latency]],...]],
+//   ["DATABASES",[["Database",Live Sessions,Idle Sessions,Waiting,Acquire Timeouts,Affinity Hits,Affinity Misses,[Statements,Statement Capacity,Statement Hits,Statement Misses,Statement Evictions],[Pool Wait]],...]],
+//   ["RESULTS",[Stored Results,Stored Bytes]],
+//   ["BUCKETS",[Bucket Upper Bounds (Microseconds)]]
+// ]]
+//   Latency = [Count,Sum (Microseconds),[Bucket,...]]
+{
+	result = "[1,[[\"CALLS\",[";
+	for (int i = 0; i < 10; ++i)
+	{
+		if (i > 0)
+		{
+			result += ",";
+		}
+		result += std::to_string(metrics_calls[i].load(std::memory_order_relaxed));
+	}
+
+	result += "]],[\"LANES\",[";
+	for (auto &lane : lanes)
+	{
+		if (result.back() != '[')
+		{
+			result += ",";
+		}
+		result += "[\"" + lane.first + "\"," + std::to_string(lane.second->getThreads()) + "," + std::to_string(lane.second->blocked_percent.load()) + "," + std::to_string(lane.second->pending.load(std::memory_order_relaxed)) + "," + std::to_string(lane.second->getQueueDepth()) + ",";
+		lane.second->queue_latency.toString(result);
+		result += "]";
+	}
+
+	result += "]],[\"PROTOCOLS\",[";
+	const protocol_registry *registry = protocols_registry.load(std::memory_order_acquire);
+	if (registry)
+	{
+		for (auto &protocol_data : registry->protocols)
+		{
+			if (result.back() != '[')
+			{
+				result += ",";
+			}
+			result += "[\"" + protocol_data->name + "\",";
+			protocol_data->latency.toString(result);
+			result += "]";
+		}
+	}
+
+	result += "]],[\"DATABASES\",[";
+	{
+		std::lock_guard<std::mutex> lock(mutex_mariadb_databases);
+		for (auto &database : mariadb_databases)
+		{
+			if (result.back() != '[')
+			{
+				result += ",";
+			}
+			result += "[\"" + database.first + "\"," + std::to_string(database.second.live_sessions.load()) + "," + std::to_string(database.second.getIdleSessions()) + "," +
+				std::to_string(database.second.getWaiting()) + "," + std::to_string(database.second.acquire_timeouts.load()) + "," +
+				std::to_string(database.second.affinity_hits.load()) + "," + std::to_string(database.second.affinity_misses.load()) + ",[" +
+				std::to_string(database.second.statement_metrics.statements.load()) + "," + std::to_string(database.second.getStatementCapacity()) + "," +
+				std::to_string(database.second.statement_metrics.hits.load()) + "," + std::to_string(database.second.statement_metrics.misses.load()) + "," +
+				std::to_string(database.second.statement_metrics.evictions.load()) + "],";
+			database.second.wait_metrics.toString(result);
+			result += "]";
+		}
+	}
+
+	ResultStore::statistics stats;
+	stored_results.getStatistics(stats);
+	result += "]],[\"RESULTS\",[" + std::to_string(stats.stored_results) + "," + std::to_string(stats.stored_bytes) + "]],[\"BUCKETS\",";
+	MetricsHistogram::boundsToString(result);
+	result += "]]]";
+}
+
+
+void Ext::getMetrics(char *output, const int &output_size)
+// Stored as Result if > output_size, same as SYNC Calls
+{
+	resultData result_data;
+	getMetrics(result_data.message);
+	if (result_data.message.length() <= output_size)
+	{
+		std::strcpy(output, result_data.message.c_str());
+	}
+	else
+	{
+		const unsigned long unique_id = saveResult(result_data);
+		if (unique_id == 0)
+		{
+			std::strcpy(output, "[0,\"Error Result Store Full\"]");
+			logger->error("extDB3: Error Result Store Full");
+		}	else {
+			std::strcpy(output, ("[2,\"" + std::to_string(unique_id) + "\"]").c_str());
+		}
+	}
+}
+
+
 void Ext::search(boost::filesystem::path &config_path, bool &conf_found, bool &conf_randomized)
 {
 	std::regex expression("extdb3-conf.*ini");
@@ -382,6 +901,7 @@ void Ext::search(boost::filesystem::path &config_path, bool &conf_found, bool &c
 void Ext::connectDatabase(char *output, const std::string &database_conf, const std::string &database_id)
 // Connection to Database, database_id used when connecting to multiple different database.
 {
+	std::lock_guard<std::mutex> lock(mutex_mariadb_databases);
 	if (mariadb_databases.count(database_id) > 0)
 	{
 		#ifdef DEBUG_TESTING
@@ -397,14 +917,22 @@ void Ext::connectDatabase(char *output, const std::string &database_conf, const
 			std::string username = ptree.get<std::string>(database_conf + ".Username");
 			std::string password = ptree.get<std::string>(database_conf + ".Password");
 			std::string database = ptree.get<std::string>(database_conf + ".Database");
+			MariaDBPool::pool_options pool_options;
+			pool_options.min_connections = ptree.get(database_conf + ".Min Connections", 1);
+			pool_options.max_connections = ptree.get(database_conf + ".Max Connections", 0);
+			pool_options.acquire_timeout = ptree.get(database_conf + ".Acquire Timeout", 10000);
+			pool_options.idle_timeout = ptree.get(database_conf + ".Idle Timeout", 600);
+			pool_options.thread_affinity = ptree.get(database_conf + ".Thread Affinity", false);
+			pool_options.max_prepared_statements = ptree.get(database_conf + ".Max Prepared Statements", 0);
 
 			MariaDBPool *database_pool = &mariadb_databases[database_id];
-			database_pool->init(ip, port, username, password, database);
+			database_pool->init(ip, port, username, password, database, pool_options);
+			logger->info("extDB3: Database: {0}, Connections: {1}, Max Connections: {2}", database_id, database_pool->live_sessions.load(), pool_options.max_connections);
 
 			if (!mariadb_idle_cleanup_timer)
 			{
-				mariadb_idle_cleanup_timer.reset(new boost::asio::deadline_timer(io_service));
-				mariadb_idle_cleanup_timer->expires_at(mariadb_idle_cleanup_timer->expires_at() + boost::posix_time::seconds(600));
+				mariadb_idle_cleanup_timer.reset(new boost::asio::deadline_timer(timer_service));
+				mariadb_idle_cleanup_timer->expires_from_now(boost::posix_time::seconds(60));
 				mariadb_idle_cleanup_timer->async_wait(boost::bind(&Ext::idleCleanup, this, _1));
 			}
 			std::strcpy(output, "[1]");
@@ -433,9 +961,15 @@ void Ext::connectDatabase(char *output, const std::string &database_conf, const
 
 void Ext::addProtocol(char *output, const std::string &database_id, const std::string &protocol, const std::string &protocol_name, const std::string &init_data)
 {
-	std::lock_guard<std::mutex> lock(mutex_vec_protocols);
-	auto foo = (std::find_if(vec_protocols.begin(), vec_protocols.end(), [=](const protocol_struct& elem) { return protocol_name == elem.name; }));
-	if (foo  != vec_protocols.end())
+	std::lock_guard<std::mutex> lock(mutex_protocols_registry);
+	const protocol_registry *registry = protocols_registry.load(std::memory_order_acquire);
+	if ((!protocol_name.empty()) && (protocol_name[0] == '#'))
+	{
+		// #<n> is parsed as a Protocol Handle, a name like that could never be called
+		std::strcpy(output, "[0,\"Error Invalid Protocol Name\"]");
+		logger->warn("extDB3: Error Invalid Protocol Name, can't start with #: {0}", protocol_name);
+	}
+	else if ((registry) && (registry->handles.count(protocol_name) > 0))
 	{
 		std::strcpy(output, "[0,\"Error Protocol Name Already Taken\"]");
 		logger->warn("extDB3: Error Protocol Name Already Taken: {0}", protocol_name);
@@ -443,13 +977,15 @@ void Ext::addProtocol(char *output, const std::string &database_id, const std::s
 	else
 	{
 		bool status = true;
-		protocol_struct protocol_data;
-		protocol_data.name = protocol_name;
+		std::shared_ptr<protocol_struct> protocol_data(new protocol_struct());
+		protocol_data->name = protocol_name;
+		auto lane_itr = lanes_protocols.find(protocol_name);
+		protocol_data->lane = (lane_itr != lanes_protocols.end()) ? lane_itr->second : default_lane;
 		if (database_id.empty())
 		{
 			if (boost::algorithm::iequals(protocol, std::string("LOG")) == 1)
 			{
-				protocol_data.protocol.reset(new LOG());
+				protocol_data->protocol.reset(new LOG());
 			}	else {
 				status = false;
 				std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
@@ -460,11 +996,11 @@ void Ext::addProtocol(char *output, const std::string &database_id, const std::s
 		{
 			if (boost::algorithm::iequals(protocol, std::string("SQL")) == 1)
 			{
-				protocol_data.protocol.reset(new SQL());
+				protocol_data->protocol.reset(new SQL());
 			}
 			else if (boost::algorithm::iequals(protocol, std::string("SQL_CUSTOM")) == 1)
 			{
-				protocol_data.protocol.reset(new SQL_CUSTOM());
+				protocol_data->protocol.reset(new SQL_CUSTOM());
 			}	else {
 				status = false;
 				std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
@@ -474,9 +1010,19 @@ void Ext::addProtocol(char *output, const std::string &database_id, const std::s
 
 		if (status)
 		{
-			if (protocol_data.protocol->init(this, database_id, init_data))
+			protocol_data->protocol->lane_ptr = protocol_data->lane;
+			if (protocol_data->protocol->init(this, database_id, init_data))
 			{
-				vec_protocols.push_back(std::move(protocol_data));
+				// Publish new Snapshot, old Snapshot stays valid for any thread still reading it
+				std::unique_ptr<protocol_registry> new_registry(new protocol_registry());
+				if (registry)
+				{
+					*new_registry = *registry;
+				}
+				new_registry->handles[protocol_data->name] = new_registry->protocols.size();
+				new_registry->protocols.push_back(std::move(protocol_data));
+				protocols_registry.store(new_registry.get(), std::memory_order_release);
+				protocols_registry_snapshots.push_back(std::move(new_registry));
 				std::strcpy(output, "[1]");
 			}	else {
 				std::strcpy(output, "[0,\"Failed to Load Protocol\"]");
@@ -487,457 +1033,606 @@ void Ext::addProtocol(char *output, const std::string &database_id, const std::s
 }
 
 
-void Ext::getSinglePartResult_mutexlock(char *output, const int &output_size, const unsigned long &unique_id)
-// Gets Result String from unordered map array -- Result Formt == Single-Message
-//   If <=, then sends output to arma, and removes entry from unordered map array
-//   If >, sends [5] to indicate MultiPartResult
+void Ext::getProtocolHandle(char *output, std::string_view protocol_name)
+// Returns Handle for Protocol, can be used instead of Protocol Name i.e 0:#<handle>:...
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
-
-	auto const_itr = stored_results.find(unique_id);
-	if (const_itr == stored_results.end()) // NO UNIQUE ID
-	{
-		std::strcpy(output, "");
-	}
-	else // SEND MSG (Part)
+	const protocol_registry *registry = protocols_registry.load(std::memory_order_acquire);
+	if (registry)
 	{
-		if (const_itr->second.wait) // WAIT
-		{
-			std::strcpy(output, "[3]");
-		}
-		else if (const_itr->second.message.length() > output_size)
-		{
-			std::strcpy(output, "[5]");
-		}
-		else
+		auto const_itr = registry->handles.find(protocol_name);
+		if (const_itr != registry->handles.end())
 		{
-			std::strcpy(output, const_itr->second.message.c_str());
-			stored_results.erase(const_itr);
+			std::strcpy(output, ("[1," + std::to_string(const_itr->second) + "]").c_str());
+			return;
 		}
 	}
+	std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
 }
 
 
-void Ext::getMultiPartResult_mutexlock(char *output, const int &output_size, const unsigned long &unique_id)
-// Gets Result String from unordered map array  -- Result Format = Multi-Message
-//   If length of String = 0, sends arma "", and removes entry from unordered map array
-//   If <=, then sends output to arma
-//   If >, then sends 1 part to arma + stores rest.
+Ext::protocol_struct *Ext::findProtocol(std::string_view protocol_name)
+// Lock-free Protocol Lookup, protocol_name is either Protocol Name or #Handle
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
-
-	auto const_itr = stored_results.find(unique_id);
-	if (const_itr == stored_results.end()) // NO UNIQUE ID or WAIT
-	{
-		std::strcpy(output, "");
-	}
-	else if (const_itr->second.wait)
+	const protocol_registry *registry = protocols_registry.load(std::memory_order_acquire);
+	if (!registry)
 	{
-		std::strcpy(output, "[3]");
+		return nullptr;
 	}
-	else if (const_itr->second.message.empty()) // END of MSG
+	if ((protocol_name.size() > 1) && (protocol_name[0] == '#'))
 	{
-		stored_results.erase(const_itr);
-		std::strcpy(output, "");
-	}
-	else // SEND MSG (Part)
-	{
-		if (const_itr->second.message.length() > output_size)
-		{
-			std::strcpy(output, const_itr->second.message.substr(0, output_size).c_str());
-			const_itr->second.message = const_itr->second.message.substr(output_size);
-		}
-		else
+		unsigned long handle = 0;
+		for (std::size_t pos = 1; pos < protocol_name.size(); ++pos)
 		{
-			std::strcpy(output, const_itr->second.message.c_str());
-			const_itr->second.message.clear();
+			if ((protocol_name[pos] < '0') || (protocol_name[pos] > '9'))
+			{
+				return nullptr;
+			}
+			handle = (handle * 10) + (protocol_name[pos] - '0');
+			if (handle >= registry->protocols.size())
+			{
+				return nullptr;
+			}
 		}
+		return registry->protocols[handle].get();
 	}
+	auto const_itr = registry->handles.find(protocol_name);
+	if (const_itr == registry->handles.end())
+	{
+		return nullptr;
+	}
+	return registry->protocols[const_itr->second].get();
 }
 
 
-const unsigned long Ext::saveResult_mutexlock(const resultData &result_data)
-// Stores Result String and returns Unique ID, used by SYNC Calls where message > outputsize
-{
-	std::lock_guard<std::mutex> lock(mutex_results);
-	const unsigned long unique_id = unique_id_counter++;
-	stored_results[unique_id] = std::move(result_data);
-	stored_results[unique_id].wait = false;
-	return unique_id;
-}
-
-
-void Ext::saveResult_mutexlock(const unsigned long &unique_id, const resultData &result_data)
-// Stores Result String for Unique ID
+void Ext::getSinglePartResult(char *output, const int &output_size, const unsigned long &unique_id)
+// Gets Result String from Result Store -- Result Formt == Single-Message
+//   If <=, then sends output to arma, and removes entry from Result Store
+//   If >, sends [5] to indicate MultiPartResult
+//   Streaming Results always send [5], size isn't known until the last row is read
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
-	stored_results[unique_id] = std::move(result_data);
-	stored_results[unique_id].wait = false;
-}
-
+	ResultStore::slot *slot_ptr;
+	switch (stored_results.lock(unique_id, slot_ptr))
+	{
+		case ResultStore::Status::NOT_FOUND: // NO UNIQUE ID
+			std::strcpy(output, "");
+			break;
+		case ResultStore::Status::WAIT: // WAIT
+			std::strcpy(output, "[3]");
+			break;
+		case ResultStore::Status::READY: // SEND MSG (Part)
+			if (slot_ptr->stream)
+			{
+				std::strcpy(output, "[5]");
+				releaseStream(slot_ptr, output_size);
+			}
+			else if (slot_ptr->message.length() > output_size)
+			{
+				std::strcpy(output, "[5]");
+				stored_results.release(slot_ptr);
+			}
+			else
+			{
+				std::strcpy(output, slot_ptr->message.c_str());
+				stored_results.erase(slot_ptr);
+			}
+			break;
+	}
+}
 
-void Ext::saveResult_mutexlock(std::vector<unsigned long> &unique_ids, const resultData &result_data)
-// Stores Result for multiple Unique IDs (used by Rcon Backend)
+
+void Ext::getMultiPartResult(char *output, const int &output_size, const unsigned long &unique_id)
+// Gets Result String from Result Store  -- Result Format = Multi-Message
+//   If nothing left to send, sends arma "", and removes entry from Result Store
+//   Else copies next part straight from stored message to arma + advances cursor
+//   Parts never end mid UTF-8 sequence
+//   Streaming Results, next part is built on the Stream's Lane as soon as current part is sent
+//     5: never returns [3] once a Stream has started, SQF loops only stop on ""
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
-	for (auto &unique_id : unique_ids)
+	ResultStore::slot *slot_ptr;
+	ResultStore::Status status = stored_results.lock(unique_id, slot_ptr);
+	while ((status == ResultStore::Status::WAIT) && (waitStreamPart(slot_ptr, output_size)))
 	{
-		stored_results[unique_id] = result_data;
-		stored_results[unique_id].wait = false;
+		status = stored_results.lock(unique_id, slot_ptr);
+	}
+	switch (status)
+	{
+		case ResultStore::Status::NOT_FOUND: // NO UNIQUE ID
+			std::strcpy(output, "");
+			break;
+		case ResultStore::Status::WAIT:
+			std::strcpy(output, "[3]");
+			break;
+		case ResultStore::Status::READY:
+		{
+			const std::size_t remaining = slot_ptr->message.length() - slot_ptr->offset;
+			if ((remaining == 0) && (slot_ptr->stream)) // Stream, no part built yet (5: without 4:)
+			{
+				postStreamPart(slot_ptr, output_size);
+				getMultiPartResult(output, output_size, unique_id);
+				break;
+			}
+			if (remaining == 0) // END of MSG
+			{
+				stored_results.erase(slot_ptr);
+				std::strcpy(output, "");
+				break;
+			}
+			const char *part = slot_ptr->message.data() + slot_ptr->offset;
+			std::size_t part_size = remaining;
+			if (part_size > static_cast<std::size_t>(output_size)) // SEND MSG (Part)
+			{
+				part_size = static_cast<std::size_t>(output_size);
+				while ((part_size > 0) && ((static_cast<unsigned char>(part[part_size]) & 0xC0) == 0x80))
+				{
+					--part_size; // Don't split UTF-8 Continuation Bytes
+				}
+				if (part_size == 0)
+				{
+					part_size = static_cast<std::size_t>(output_size);
+				}
+			}
+			std::memcpy(output, part, part_size);
+			output[part_size] = '\0';
+			slot_ptr->offset += part_size;
+			if ((slot_ptr->stream) && (slot_ptr->offset == slot_ptr->message.length()))
+			{
+				postStreamPart(slot_ptr, output_size); // Read ahead
+			}
+			else
+			{
+				stored_results.release(slot_ptr);
+			}
+			break;
+		}
 	}
 }
 
 
-void Ext::syncCallProtocol(char *output, const int &output_size, std::string &input_str)
-// Sync callPlugin
+void Ext::getBatchResults(char *output, const int &output_size, const std::vector<unsigned long> &unique_ids)
+// Gets Result Strings for multiple Unique IDs in one call
+//   Returns [1,[["ID",RESULT],...],[["ID",SIZE],...]]
+//   Ready + fits in output, result is sent + removed from Result Store
+//   Ready + doesn't fit, size is sent instead, fetch it via 5:ID
+//   Streaming Results size is sent as -1
+//   Pending / Unknown IDs are left out
 {
-	const std::string::size_type found = input_str.find(":",2);
+	std::string ready_str;
+	std::string multipart_str;
+	const std::size_t max_size = static_cast<std::size_t>(output_size) - 9; // [1,[...],[...]]
 
-	if ((found==std::string::npos) || (found == (call_extension_input_str_length - 1)))
-	{
-		std::strcpy(output, "[0,\"Error Invalid Format\"]");
-		logger->error("extDB3: Invalid Format: {0}", input_str);
-	}
-	else
+	ResultStore::slot *slot_ptr;
+	for (auto &unique_id : unique_ids)
 	{
-		std::string protocol_name = input_str.substr(2, (found - 2));
-		auto const_itr = (std::find_if(vec_protocols.begin(), vec_protocols.end(), [=](const protocol_struct& elem) { return protocol_name == elem.name; }));
-		if (const_itr == vec_protocols.end())
+		if (stored_results.lock(unique_id, slot_ptr) != ResultStore::Status::READY)
 		{
-			std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
+			continue;
+		}
+		const std::string id = std::to_string(unique_id);
+		const std::size_t size = slot_ptr->message.length() - slot_ptr->offset;
+		if ((!slot_ptr->stream) && (slot_ptr->offset == 0) && ((ready_str.length() + multipart_str.length() + size + id.length() + 6) <= max_size))
+		{
+			if (!ready_str.empty())
+			{
+				ready_str += ",";
+			}
+			ready_str += "[\"" + id + "\"," + slot_ptr->message + "]";
+			stored_results.erase(slot_ptr);
 		}
 		else
 		{
-			resultData result_data;
-			result_data.message.reserve(output_size);
-
-			const_itr->protocol->callProtocol(input_str.substr(found+1), result_data.message, false);
-			if (result_data.message.length() <= output_size)
+			const bool is_stream = static_cast<bool>(slot_ptr->stream);
+			if (is_stream)
 			{
-				std::strcpy(output, result_data.message.c_str());
+				releaseStream(slot_ptr, output_size);
 			}
 			else
 			{
-				const unsigned long unique_id = saveResult_mutexlock(result_data);
-				std::strcpy(output, ("[2,\"" + std::to_string(unique_id) + "\"]").c_str());
+				stored_results.release(slot_ptr);
+			}
+			const std::string entry = "[\"" + id + "\"," + (is_stream ? std::string("-1") : std::to_string(size)) + "]";
+			if ((ready_str.length() + multipart_str.length() + entry.length() + 1) <= max_size)
+			{
+				if (!multipart_str.empty())
+				{
+					multipart_str += ",";
+				}
+				multipart_str += entry;
 			}
 		}
 	}
+	std::strcpy(output, ("[1,[" + ready_str + "],[" + multipart_str + "]]").c_str());
 }
 
 
-void Ext::onewayCallProtocol(std::string &input_str)
-// ASync callProtocol
+const unsigned long Ext::saveResult(resultData &result_data)
+// Stores Result String and returns Unique ID, used by SYNC Calls where message > outputsize
+//   Returns 0 if Result Store is Full
 {
-	const std::string::size_type found = input_str.find(":",2);
-	if ((found==std::string::npos) || (found == (input_str.size() - 1)))
+	return stored_results.save(std::move(result_data.message));
+}
+
+
+void Ext::saveResult(const unsigned long &unique_id, resultData &result_data)
+// Stores Result String for Unique ID
+{
+	stored_results.complete(unique_id, std::move(result_data.message));
+}
+
+
+void Ext::saveResult(std::vector<unsigned long> &unique_ids, const resultData &result_data)
+// Stores Result for multiple Unique IDs (used by Rcon Backend)
+{
+	for (auto &unique_id : unique_ids)
 	{
-		logger->error("extDB3: Invalid Format: {0}", input_str);
+		stored_results.complete(unique_id, std::string(result_data.message));
 	}
-	else
+}
+
+
+unsigned long Ext::saveResultStream(const unsigned long &unique_id, std::unique_ptr<ResultStream> &&stream)
+// Stores Streaming Result, used by SQL_CUSTOM Streaming Calls
+{
+	if (!stream->lane)
 	{
-		std::string protocol_name = input_str.substr(2, (found - 2));
-		auto const_itr = (std::find_if(vec_protocols.begin(), vec_protocols.end(), [=](const protocol_struct& elem) { return protocol_name == elem.name; }));
-		if (const_itr != vec_protocols.end())
-		{
-			resultData result_data;
-			const_itr->protocol->callProtocol(input_str.substr(found+1), result_data.message, true);
-		}
+		stream->lane = default_lane;
 	}
+	if (unique_id == 0)
+	{
+		return stored_results.saveStream(std::move(stream));
+	}
+	if (stored_results.completeStream(unique_id, std::move(stream)))
+	{
+		return unique_id;
+	}
+	return 0;
 }
 
 
-void Ext::asyncCallProtocol(const int &output_size, const std::string &protocol_name, const std::string &data, const unsigned long unique_id)
-// ASync + Save callProtocol
-// We check if Protocol exists here, since its a thread (less time spent blocking arma) and it shouldnt happen anyways
+void Ext::releaseStream(ResultStore::slot *slot_ptr, const int &output_size)
+// Unlocks Stream slot, first part is started straight away so it is ready by the first 5:
 {
-	resultData result_data;
-	result_data.message.reserve(output_size);
-	auto const_itr = (std::find_if(vec_protocols.begin(), vec_protocols.end(), [=](const protocol_struct& elem) { return protocol_name == elem.name; }));
-	if (const_itr->protocol->callProtocol(data, result_data.message, true, unique_id))
+	if (slot_ptr->message.empty())
+	{
+		postStreamPart(slot_ptr, output_size);
+	}
+	else
 	{
-		saveResult_mutexlock(unique_id, result_data);
+		stored_results.release(slot_ptr);
 	}
 }
 
 
-void Ext::getUPTime(std::string &token, std::string &result)
+void Ext::postStreamPart(ResultStore::slot *slot_ptr, const int &output_size)
+// Hands locked Stream slot to its Lane, slot stays BUSY (4: returns [3], 5: waits) until next part is stored
 {
-	uptime_current = std::chrono::steady_clock::now();
-	auto uptime_diff = uptime_current - uptime_start;
-	if (token == "MINUTES")
+	slot_ptr->message.clear();
+	slot_ptr->offset = 0;
+	stored_results.queuePart(slot_ptr);
+	slot_ptr->stream->lane->post([this, slot_ptr, output_size]()
 	{
-		result = std::to_string(std::chrono::duration_cast<std::chrono::minutes>(uptime_diff).count());
+		if (stored_results.claimPart(slot_ptr))
+		{
+			buildStreamPart(slot_ptr, output_size);
+		}
+	});
+}
+
+
+bool Ext::waitStreamPart(ResultStore::slot *slot_ptr, const int &output_size)
+// Game Thread -- 5: found slot BUSY, returns false if it isn't a Stream part on its way (plain WAIT)
+//   Part still queued behind other work on the Lane is built here instead, part already being built is waited for
+{
+	switch (slot_ptr->part.load(std::memory_order_acquire))
+	{
+		case ResultStore::Part::QUEUED:
+			if (stored_results.claimPart(slot_ptr))
+			{
+				buildStreamPart(slot_ptr, output_size);
+			}
+			return true;
+		case ResultStore::Part::BUILDING:
+		case ResultStore::Part::STORED:
+			std::this_thread::yield();
+			return true;
+		default:
+			return false;
 	}
-	else if (token == "HOURS")
+}
+
+
+void Ext::buildStreamPart(ResultStore::slot *slot_ptr, const int output_size)
+// Lane Worker, or Game Thread if 5: arrives before the Lane got to it
+//   Stream Error (i.e Connection lost) ends the Stream with part [0,"Error Stream"], so SQF never mistakes a truncated result for a complete one
+{
+	std::string part;
+	bool more = false;
+	try
 	{
-		result = std::to_string(std::chrono::duration_cast<std::chrono::hours>(uptime_diff).count());
+		more = slot_ptr->stream->next(part, static_cast<std::size_t>(output_size));
 	}
-	else if (token == "SECONDS")
+	catch (std::exception const &e)
 	{
-		result = std::to_string(std::chrono::duration_cast<std::chrono::seconds>(uptime_diff).count());
-	} else {
-		result = "[0,\"Error Invalid Format\"]";
 		#ifdef DEBUG_TESTING
-			console->info("extDB3: getUPTime: invalid input: {0}", token);
+			console->error("extDB3: Stream Error: {0}", e.what());
 		#endif
-		logger->info("extDB3: getUPTime: invalid input: {0}", token);
+		logger->error("extDB3: Stream Error: {0}", e.what());
+		part = "[0,\"Error Stream\"]";
+		more = false;
 	}
+	stored_results.storePart(slot_ptr, std::move(part), more);
 }
 
 
-void Ext::getUPTime2(std::string &token, std::string &result)
+void Ext::registerCallback(callback_function callback)
+// RVExtensionRegisterCallback
 {
-	uptime_current = std::chrono::steady_clock::now();
-	auto uptime_diff = uptime_current - uptime_start;
-	if (token == "MINUTES")
+	callback_ptr.store(callback, std::memory_order_release);
+	logger->info("extDB3: Registered Extension Callback");
+}
+
+
+void Ext::pushResult(const int &output_size, const unsigned long &unique_id)
+// Pushes stored result to arma via Extension Callback  -- name = "extDB3", function = Unique ID
+//   If <=, then sends result, and removes entry from Result Store
+//   If >, sends [5] to indicate MultiPartResult, SQF fetches via 5:Unique ID
+//   If Callback Queue is Full, result stays stored + push is retried until delivered or result is evicted (Result TTL)
+{
+	retryPushResults();
+	if (!tryPushResult(output_size, unique_id))
 	{
-		result = "[1," + std::to_string(std::chrono::duration_cast<std::chrono::minutes>(uptime_diff).count()) + "]";
+		logger->warn("extDB3: Callback Queue Full, Retrying, Unique ID: {0}", unique_id);
+		std::lock_guard<std::mutex> lock(mutex_push_retry);
+		push_retry_ids.emplace_back(unique_id, output_size);
+		armPushRetry();
 	}
-	else if (token == "HOURS")
+}
+
+
+void Ext::armPushRetry()
+// mutex_push_retry must be held
+{
+	if (!push_retry_armed)
 	{
-		result = "[1," + std::to_string(std::chrono::duration_cast<std::chrono::hours>(uptime_diff).count()) + "]";
+		if (!push_retry_timer)
+		{
+			push_retry_timer.reset(new boost::asio::deadline_timer(timer_service));
+		}
+		push_retry_timer->expires_from_now(boost::posix_time::seconds(1));
+		push_retry_timer->async_wait(boost::bind(&Ext::pushRetry, this, _1));
+		push_retry_armed = true;
 	}
-	else if (token == "SECONDS")
+}
+
+
+bool Ext::tryPushResult(const int &output_size, const unsigned long &unique_id)
+// Returns false if Callback Queue is Full, result is left stored
+//   Stream whose pushed part is still being built (earlier push failed) is retried too
+{
+	callback_function callback = callback_ptr.load(std::memory_order_acquire);
+	if (callback == nullptr)
 	{
-		result = result = "[1," + std::to_string(std::chrono::duration_cast<std::chrono::seconds>(uptime_diff).count()) + "]";
-	} else {
-		result = "[0,\"Error Invalid Format\"]";
-		#ifdef DEBUG_TESTING
-			console->info("extDB3: getUPTime: invalid input: {0}", token);
-		#endif
-		logger->info("extDB3: getUPTime: invalid input: {0}", token);
+		return true;
 	}
+	ResultStore::slot *slot_ptr;
+	switch (stored_results.lock(unique_id, slot_ptr))
+	{
+		case ResultStore::Status::NOT_FOUND:
+			return true;
+		case ResultStore::Status::WAIT:
+			return (slot_ptr->part.load(std::memory_order_acquire) == ResultStore::Part::NONE);
+		case ResultStore::Status::READY:
+			break;
+	}
+	const std::string id = std::to_string(unique_id);
+	if (slot_ptr->stream)
+	{
+		releaseStream(slot_ptr, output_size);
+		return (callback("extDB3", id.c_str(), "[5]") >= 0);
+	}
+	else if (slot_ptr->message.length() > output_size)
+	{
+		stored_results.release(slot_ptr);
+		return (callback("extDB3", id.c_str(), "[5]") >= 0);
+	}
+	else if (callback("extDB3", id.c_str(), slot_ptr->message.c_str()) < 0)
+	{
+		stored_results.release(slot_ptr);
+		return false;
+	}
+	stored_results.erase(slot_ptr);
+	return true;
 }
 
 
-void Ext::getDateAdd(std::string &token, std::string &token2, std::string &result)
+void Ext::retryPushResults()
+// Worker / Timer Thread, each pending push is taken by one thread only
 {
-	try
+	std::vector<std::pair<unsigned long, int>> retry_ids;
 	{
-		if (token.length() > 2)
+		std::lock_guard<std::mutex> lock(mutex_push_retry);
+		if (push_retry_ids.empty())
 		{
-			token.erase(0, 1);
-			token.pop_back();
-			std::vector<std::string> vec;
-			boost::split(vec, token, boost::is_any_of(","));
+			return;
+		}
+		retry_ids.swap(push_retry_ids);
+	}
+	std::vector<std::pair<unsigned long, int>> failed_ids;
+	for (auto &retry_id : retry_ids)
+	{
+		if (!tryPushResult(retry_id.second, retry_id.first))
+		{
+			failed_ids.push_back(retry_id);
+		}
+	}
+	if (!failed_ids.empty())
+	{
+		std::lock_guard<std::mutex> lock(mutex_push_retry);
+		push_retry_ids.insert(push_retry_ids.end(), failed_ids.begin(), failed_ids.end());
+		armPushRetry(); // Timer may have found the list empty while this thread held it
+	}
+}
+
 
-			if (vec.size() == 6)
+void Ext::pushRetry(const boost::system::error_code& ec)
+// Callback Queue was Full, retries every second on Timer Thread until nothing is left to push
+{
+	if (!ec)
+	{
+		retryPushResults();
+		std::lock_guard<std::mutex> lock(mutex_push_retry);
+		{
+			if (push_retry_timer)
 			{
-				int year = std::stoi(vec[0], nullptr);
-				year = year - 1900;
-				int month = std::stoi(vec[1], nullptr);
-				month = month - 1;
-				int day = std::stoi(vec[2], nullptr);
-				int hour = std::stoi(vec[3], nullptr);
-				int minute = std::stoi(vec[4], nullptr);
-				int second = std::stoi(vec[5], nullptr);
-				
-				struct tm ptime_tm = { second,minute,hour,day,month,year };
-				ptime = boost::posix_time::ptime_from_tm(ptime_tm);
-
-				if (token2.length() > 2)
+				if (push_retry_ids.empty())
 				{
-					token2.erase(0, 1);
-					token2.pop_back();
-					std::vector<std::string> vec;
-					boost::split(vec, token2, boost::is_any_of(","));
-					if (vec.size() == 4)
-					{
-						int hours = std::stoi(vec[0], nullptr) * 24;
-						hours = hours + std::stoi(vec[1], nullptr);
-						int minutes = std::stoi(vec[2], nullptr);
-						int seconds = std::stoi(vec[3], nullptr);
-
-						boost::posix_time::time_duration diff(hours, minutes, seconds, 0);
-						ptime = ptime + diff;
-
-						facet = new boost::posix_time::time_facet();
-						facet->format("[1,[%Y,%m,%d,%H,%M,%S]]");
-						std::stringstream ss2;
-						ss2.imbue(std::locale(std::locale::classic(), facet));
-						ss2 << ptime;
-						result = ss2.str();
-					}
-					else {
-						result = "[0,\"Error Invalid Format\"]";
-						#ifdef DEBUG_TESTING
-							console->info("extDB3: addDate: invalid input: {0}", token2);
-						#endif
-						logger->info("extDB3: addDate: invalid input: {0}", token2);
-					}
-				}
-				else {
-					result = "[0,\"Error Invalid Format\"]";
-					#ifdef DEBUG_TESTING
-						console->info("extDB3: addDate: invalid input2: {0}", token2);
-					#endif
-					logger->info("extDB3: addDate: invalid input2: {0}", token2);
+					push_retry_armed = false;
+				} else {
+					push_retry_timer->expires_from_now(boost::posix_time::seconds(1));
+					push_retry_timer->async_wait(boost::bind(&Ext::pushRetry, this, _1));
 				}
 			}
-			else {
-				result = "[0,\"Error Invalid Format\"]";
-				#ifdef DEBUG_TESTING
-					console->info("extDB3: addDate: invalid input3: {0}", token);
-				#endif
-				logger->info("extDB3: addDate: invalid input3: {0}", token);
-			}
-
 		}
 	}
-	catch(std::exception const &e)
-	{
-		result = "[0,\"Error Invalid Format\"]";
-		#ifdef DEBUG_TESTING
-			console->info("extDB3: addDate: stdException: {0}", e.what());
-		#endif
-		logger->info("extDB3: addDate: stdException: {0}", e.what());
-	}
 }
 
 
-void Ext::getLocalTime(std::string &result)
+void Ext::getResultStats(char *output)
+// [1,[Stored Results, Stored Bytes, Evicted Results, Evicted Waits, Rejected Results, Streams, Evicted Streams]]
 {
-	ptime = boost::posix_time::second_clock::local_time();
-	std::stringstream stream;
-	facet = new boost::posix_time::time_facet();
-	facet->format("[1,[%Y,%m,%d,%H,%M,%S]]");
-	stream.imbue(std::locale(std::locale::classic(), facet));
-	stream << ptime;
-	result = stream.str();
+	ResultStore::statistics stats;
+	stored_results.getStatistics(stats);
+	std::strcpy(output, ("[1,[" + std::to_string(stats.stored_results) + "," + std::to_string(stats.stored_bytes) + "," + std::to_string(stats.evicted_results) + "," + std::to_string(stats.evicted_waits) + "," + std::to_string(stats.rejected_results) + "," +
+		std::to_string(stats.streams) + "," + std::to_string(stats.evicted_streams) + "]]").c_str());
 }
 
 
-void Ext::getLocalTime(std::string &input_str, std::string &result)
+void Ext::syncCallProtocol(char *output, const int &output_size, std::string_view input_str)
+// Sync callPlugin, input_str views the whole null-terminated Input from Arma
 {
-	try
-	{
-		ptime = boost::posix_time::second_clock::local_time();
+	const std::string_view::size_type found = input_str.find(':', 2);
 
-		if (!(input_str.empty()))
+	if ((found==std::string_view::npos) || (found == (call_extension_input_str_length - 1)))
+	{
+		std::strcpy(output, "[0,\"Error Invalid Format\"]");
+		logger->error("extDB3: Invalid Format: {0}", input_str.data());
+	}
+	else
+	{
+		protocol_struct *protocol_data = findProtocol(input_str.substr(2, (found - 2)));
+		if (!protocol_data)
 		{
-			int offset;
-			if (input_str[0] == '[')
-			{
-				input_str.erase(0,1);
-				input_str.pop_back();
+			std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
+		}
+		else
+		{
+			resultData result_data;
+			result_data.message.reserve(output_size);
 
-				std::vector<std::string> tokens;
-				boost::split(tokens, input_str, boost::is_any_of(","));
-				for (unsigned int i = 0; i < tokens.size(); i++)
+			const auto start = std::chrono::steady_clock::now();
+			protocol_data->protocol->callProtocol(input_str.substr(found+1), result_data.message, false);
+			protocol_data->latency.record(start);
+			if (result_data.message.length() <= output_size)
+			{
+				std::strcpy(output, result_data.message.c_str());
+			}
+			else
+			{
+				const unsigned long unique_id = saveResult(result_data);
+				if (unique_id == 0)
 				{
-					offset = std::stoi(tokens[i]);
-					switch (i)
-					{
-						case 0:
-							break;
-						case 1:
-							break;
-						case 2:
-							ptime += boost::posix_time::hours(offset * 24);
-						case 3:
-							ptime += boost::posix_time::hours(offset);
-						case 4:
-							ptime += boost::posix_time::minutes(offset);
-						case 5:
-							ptime += boost::posix_time::seconds(offset);
-						default:
-							break;
-					}
+					std::strcpy(output, "[0,\"Error Result Store Full\"]");
+					logger->error("extDB3: Error Result Store Full");
+				}	else {
+					std::strcpy(output, ("[2,\"" + std::to_string(unique_id) + "\"]").c_str());
 				}
-			} else {
-				offset = std::stoi(input_str);
-				ptime += boost::posix_time::hours(offset);
 			}
 		}
+	}
+}
+
+
+void Ext::onewayCallProtocol(protocol_struct *protocol_data, std::string &data)
+// ASync callProtocol
+{
+	resultData result_data;
+	const auto start = std::chrono::steady_clock::now();
+	protocol_data->protocol->callProtocol(std::move(data), result_data.message, true);
+	protocol_data->latency.record(start);
+}
+
 
-		std::stringstream stream;
-		facet = new boost::posix_time::time_facet();
-		facet->format("[1,[%Y,%m,%d,%H,%M,%S]]");
-		stream.imbue(std::locale(std::locale::classic(), facet));
-		stream << ptime;
-		result = stream.str();
+void Ext::asyncCallProtocol(const int &output_size, protocol_struct *protocol_data, std::string &data, const unsigned long unique_id, const bool callback)
+// ASync + Save callProtocol
+// Protocol already resolved by callExtension
+{
+	resultData result_data;
+	result_data.message.reserve(output_size);
+	const auto start = std::chrono::steady_clock::now();
+	const bool status = protocol_data->protocol->callProtocol(std::move(data), result_data.message, true, unique_id);
+	protocol_data->latency.record(start);
+	if (status)
+	{
+		saveResult(unique_id, result_data);
 	}
-	catch(std::exception& e)
+	if (callback)
 	{
-		result = "[0,\"ERROR\"]";
+		pushResult(output_size, unique_id); // Streaming Results are stored by the Protocol itself
 	}
 }
 
 
-void Ext::getUTCTime(std::string &result)
+void Ext::syncCallProtocolArgs(char *output, const int &output_size, protocol_struct *protocol_data, std::vector<std::string> &tokens)
+// Sync callProtocol -- RVExtensionArgs
 {
-	try
-	{
-		ptime = boost::posix_time::second_clock::universal_time();
+	resultData result_data;
+	result_data.message.reserve(output_size);
 
-		std::stringstream stream;
-		facet = new boost::posix_time::time_facet();
-		facet->format("[1,[%Y,%m,%d,%H,%M,%S]]");
-		stream.imbue(std::locale(std::locale::classic(), facet));
-		stream << ptime;
-		result = stream.str();
+	const auto start = std::chrono::steady_clock::now();
+	protocol_data->protocol->callProtocol(tokens, result_data.message, false);
+	protocol_data->latency.record(start);
+	if (result_data.message.length() <= output_size)
+	{
+		std::strcpy(output, result_data.message.c_str());
 	}
-	catch(std::exception& e)
+	else
 	{
-		result = "[0,\"ERROR\"]";
+		const unsigned long unique_id = saveResult(result_data);
+		if (unique_id == 0)
+		{
+			std::strcpy(output, "[0,\"Error Result Store Full\"]");
+			logger->error("extDB3: Error Result Store Full");
+		}	else {
+			std::strcpy(output, ("[2,\"" + std::to_string(unique_id) + "\"]").c_str());
+		}
 	}
 }
 
 
-void Ext::getUTCTime(std::string &input_str, std::string &result)
+void Ext::onewayCallProtocolArgs(protocol_struct *protocol_data, std::vector<std::string> &tokens)
+// ASync callProtocol -- RVExtensionArgs
 {
-	try
-	{
-		ptime = boost::posix_time::second_clock::universal_time();
-
-		if (!(input_str.empty()))
-		{
-			int offset;
-			if (input_str[0] == '[')
-			{
-				input_str.erase(0,1);
-				input_str.pop_back();
+	resultData result_data;
+	const auto start = std::chrono::steady_clock::now();
+	protocol_data->protocol->callProtocol(tokens, result_data.message, true);
+	protocol_data->latency.record(start);
+}
 
-				std::vector<std::string> tokens;
-				boost::split(tokens, input_str, boost::is_any_of(","));
-				for (unsigned int i = 0; i < tokens.size(); i++)
-				{
-					offset = std::stoi(tokens[i]);
-					switch (i)
-					{
-						case 0:
-							break;
-						case 1:
-							break;
-						case 2:
-							ptime += boost::posix_time::hours(offset*24);
-						case 3:
-							ptime += boost::posix_time::hours(offset);
-						case 4:
-							ptime += boost::posix_time::minutes(offset);
-						case 5:
-							ptime += boost::posix_time::seconds(offset);
-						default:
-							break;
-					}
-				}
-			} else {
-				offset = std::stoi(input_str);
-				ptime += boost::posix_time::hours(offset);
-			}
-		}
 
-		std::stringstream stream;
-		facet = new boost::posix_time::time_facet();
-		facet->format("[1,[%Y,%m,%d,%H,%M,%S]]");
-		stream.imbue(std::locale(std::locale::classic(), facet));
-		stream << ptime;
-		result = stream.str();
+void Ext::asyncCallProtocolArgs(const int &output_size, protocol_struct *protocol_data, std::vector<std::string> &tokens, const unsigned long unique_id, const bool callback)
+// ASync + Save callProtocol -- RVExtensionArgs
+{
+	resultData result_data;
+	result_data.message.reserve(output_size);
+	const auto start = std::chrono::steady_clock::now();
+	const bool status = protocol_data->protocol->callProtocol(tokens, result_data.message, true, unique_id);
+	protocol_data->latency.record(start);
+	if (status)
+	{
+		saveResult(unique_id, result_data);
 	}
-	catch(std::exception& e)
+	if (callback)
 	{
-		result = "[0,\"ERROR\"]";
+		pushResult(output_size, unique_id); // Streaming Results are stored by the Protocol itself
 	}
 }
 
@@ -950,49 +1645,75 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 			logger->info("extDB3: Input from Server: {0}", std::string(function));
 		#endif
 
-		std::string input_str(function);
+		// Parsed in place, Input is only copied when handed to a Worker Thread
+		const std::string_view input_str(function);
 		call_extension_input_str_length = input_str.length();
 
 		if (call_extension_input_str_length <= 2)
 		{
 			std::strcpy(output, "[0,\"Error Invalid Message\"]");
-			logger->info("extDB3: Invalid Message: {0}", input_str);
+			logger->info("extDB3: Invalid Message: {0}", function);
 		}
 		else
 		{
+			if ((input_str[0] >= '0') && (input_str[0] <= '9'))
+			{
+				metrics_calls[input_str[0] - '0'].fetch_add(1, std::memory_order_relaxed);
+			}
+
 			// Async / Sync
 			switch (input_str[0])
 			{
 				case '1': //ASYNC
 				{
-					io_service.post(boost::bind(&Ext::onewayCallProtocol, this, std::move(input_str)));
+					const std::string_view::size_type found = input_str.find(':', 2);
+					if ((found==std::string_view::npos) || (found == (call_extension_input_str_length - 1)))
+					{
+						logger->error("extDB3: Invalid Format: {0}", function);
+					}	else {
+						protocol_struct *protocol_data = findProtocol(input_str.substr(2, (found - 2)));
+						if (protocol_data)
+						{
+							if (!protocol_data->lane->submit([this, protocol_data, data = std::string(input_str.substr(found+1))]() mutable { onewayCallProtocol(protocol_data, data); }))
+							{
+								std::strcpy(output, "[0,\"Error Queue Full\"]");
+							}
+						}
+					}
 					break;
 				}
 				case '2': //ASYNC + SAVE
+				case '3': //ASYNC + SAVE + CALLBACK
 				{
 					// Protocol
-					const std::string::size_type found = input_str.find(":", 2);
-					if ((found==std::string::npos) || (found == (call_extension_input_str_length - 1)))
+					const std::string_view::size_type found = input_str.find(':', 2);
+					if ((found==std::string_view::npos) || (found == (call_extension_input_str_length - 1)))
 					{
 						std::strcpy(output, "[0,\"Error Invalid Format\"]");
-						logger->error("extDB3: Error Invalid Format: {0}", input_str);
+						logger->error("extDB3: Error Invalid Format: {0}", function);
+					}	else if ((input_str[0] == '3') && (callback_ptr.load(std::memory_order_acquire) == nullptr)) {
+						std::strcpy(output, "[0,\"Error Callback Not Registered\"]");
+						logger->error("extDB3: Error Callback Not Registered: {0}", function);
 					}	else {
 						// Check for Protocol Name Exists...
 						// Do this so if someone manages to get server, the error message wont get stored in the result unordered map
-						const std::string protocol_name = input_str.substr(2,(found-2));
-						if ((std::find_if(vec_protocols.begin(), vec_protocols.end(), [=](const protocol_struct& elem) { return protocol_name == elem.name; })) != vec_protocols.end()) //TODO Change to ITER
+						const std::string_view protocol_name = input_str.substr(2,(found-2));
+						protocol_struct *protocol_data = findProtocol(protocol_name);
+						if (protocol_data)
 						{
-							unsigned long unique_id;
+							const unsigned long unique_id = stored_results.reserve();
+							if (unique_id == 0)
 							{
-								std::lock_guard<std::mutex> lock(mutex_results);
-								unique_id = unique_id_counter++;
-								stored_results[unique_id].wait = true;
+								std::strcpy(output, "[0,\"Error Result Store Full\"]");
+								logger->error("extDB3: Error Result Store Full: Input String: {0}", function);
+							}	else {
+								const bool callback = (input_str[0] == '3');
+								protocol_data->lane->post([this, output_size, protocol_data, data = std::string(input_str.substr(found+1)), unique_id, callback]() mutable { asyncCallProtocol(output_size, protocol_data, data, unique_id, callback); });
+								std::strcpy(output, ("[2,\"" + std::to_string(unique_id) + "\"]").c_str());
 							}
-							io_service.post(boost::bind(&Ext::asyncCallProtocol, this, output_size, std::move(protocol_name), input_str.substr(found+1), std::move(unique_id)));
-							std::strcpy(output, ("[2,\"" + std::to_string(unique_id) + "\"]").c_str());
 						}	else {
 							std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
-							logger->error("extDB3: Error Unknown Protocol: {0}  Input String: {1}", protocol_name, input_str);
+							logger->error("extDB3: Error Unknown Protocol: {0}  Input String: {1}", std::string(protocol_name), function);
 						}
 					}
 					break;
@@ -1000,15 +1721,33 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 				case '4': // GET -- Single-Part Message Format
 				{
 					//const unsigned long unique_id = std::stoul(input_str.substr(2));
-					const unsigned long unique_id = strtoul (input_str.substr(2).c_str(), NULL, 0);
-					getSinglePartResult_mutexlock(output, output_size, unique_id);
+					const unsigned long unique_id = strtoul (function + 2, NULL, 0);
+					getSinglePartResult(output, output_size, unique_id);
 					break;
 				}
 				case '5': // GET -- Multi-Part Message Format
 				{
 					//const unsigned long unique_id = std::stoul(input_str.substr(2));
-					const unsigned long unique_id = strtoul (input_str.substr(2).c_str(), NULL, 0);
-					getMultiPartResult_mutexlock(output, output_size, unique_id);
+					const unsigned long unique_id = strtoul (function + 2, NULL, 0);
+					getMultiPartResult(output, output_size, unique_id);
+					break;
+				}
+				case '6': // GET -- Batch of Unique IDs  6:ID,ID,ID
+				{
+					std::vector<unsigned long> unique_ids;
+					const char *pos = function + 2;
+					while (*pos != '\0')
+					{
+						if ((*pos >= '0') && (*pos <= '9'))
+						{
+							char *end;
+							unique_ids.push_back(strtoul(pos, &end, 0));
+							pos = end;
+						}	else {
+							++pos;  // Skip , [ ] " and spaces
+						}
+					}
+					getBatchResults(output, output_size, unique_ids);
 					break;
 				}
 				case '0': //SYNC
@@ -1018,48 +1757,51 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 				}
 				case '9': // SYSTEM CALLS / SETUP
 				{
-					std::vector<std::string> tokens;
-					boost::split(tokens, input_str, boost::is_any_of(":"));
+					std::string_view tokens[6];
+					const std::size_t tokens_size = splitTokens(input_str, tokens, 6);
 
 					if (ext_info.extDB_lock)
 					{
-						switch (tokens.size())
+						switch (tokens_size)
 						{
 							case 4:
 								if (tokens[1] == "DATEADD")
 								{
-									std::string result;
-									getDateAdd(tokens[2],tokens[3],result);
-									std::strcpy(output, result.c_str());
+									if (!time_service.getDateAdd(output, tokens[2], tokens[3]))
+									{
+										logger->info("extDB3: DATEADD: invalid input: {0}", function);
+									}
 								}	else {
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB3: Error Invalid Format: {0}", input_str);
+									logger->error("extDB3: Error Invalid Format: {0}", function);
 								}
 								break;
 							case 3:
 								if (tokens[1] == "UPTIME2")
 								{
-									std::string result;
-									getUPTime2(tokens[2], result);
-									std::strcpy(output, result.c_str());
+									if (!time_service.getUPTime(output, tokens[2], true))
+									{
+										logger->info("extDB3: UPTIME: invalid input: {0}", function);
+									}
 								}
 								else if (tokens[1] == "UPTIME")
 								{
-									std::string result;
-									getUPTime(tokens[2], result);
-									std::strcpy(output, result.c_str());
+									if (!time_service.getUPTime(output, tokens[2], false))
+									{
+										logger->info("extDB3: UPTIME: invalid input: {0}", function);
+									}
 								}
 								else if (tokens[1] == "LOCAL_TIME")
 								{
-									std::string result;
-									getLocalTime(tokens[2], result);
-									std::strcpy(output, result.c_str());
+									time_service.getTime(output, TimeService::LOCAL, tokens[2]);
 								}
 								else if (tokens[1] == "UTC_TIME")
 								{
-									std::string result;
-									getUTCTime(tokens[2], result);
-									std::strcpy(output, result.c_str());
+									time_service.getTime(output, TimeService::UTC, tokens[2]);
+								}
+								else if (tokens[1] == "PROTOCOL_HANDLE")
+								{
+									getProtocolHandle(output, tokens[2]);
 								}
 								else if (tokens[1] == "UNLOCK")
 								{
@@ -1076,21 +1818,17 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 									}
 								}	else {
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB3: Error Invalid Format: {0}", input_str);
+									logger->error("extDB3: Error Invalid Format: {0}", function);
 								}
 								break;
 							case 2:
 								if (tokens[1] == "LOCAL_TIME")
 								{
-									std::string result;
-									getLocalTime(result);
-									std::strcpy(output, result.c_str());
+									time_service.getTime(output, TimeService::LOCAL);
 								}
 								else if (tokens[1] == "UTC_TIME")
 								{
-									std::string result;
-									getUTCTime(result);
-									std::strcpy(output, result.c_str());
+									time_service.getTime(output, TimeService::UTC);
 								}
 								else if (tokens[1] == "UNLOCK")
 								{
@@ -1104,34 +1842,42 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 								{
 									std::strcpy(output, EXTDB_VERSION);
 								}
+								else if (tokens[1] == "RESULT_STATS")
+								{
+									getResultStats(output);
+								}
+								else if (tokens[1] == "QUEUE_DEPTH")
+								{
+									getQueueDepth(output, output_size);
+								}
+								else if (tokens[1] == "METRICS")
+								{
+									getMetrics(output, output_size);
+								}
 								else
 								{
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB3: Error Invalid Format: {0}", input_str);
+									logger->error("extDB3: Error Invalid Format: {0}", function);
 								}
 								break;
 							default:
 								// Invalid Format
 								std::strcpy(output, "[0,\"Error Invalid Format\"]");
-								logger->error("extDB3: Error Invalid Format: {0}", input_str);
+								logger->error("extDB3: Error Invalid Format: {0}", function);
 						}
 					}
 					else
 					{
-						switch (tokens.size())
+						switch (tokens_size)
 						{
 							case 2:
 								if (tokens[1] == "LOCAL_TIME")
 								{
-									std::string result;
-									getLocalTime(result);
-									std::strcpy(output, result.c_str());
+									time_service.getTime(output, TimeService::LOCAL);
 								}
 								else if (tokens[1] == "UTC_TIME")
 								{
-									std::string result;
-									getUTCTime(result);
-									std::strcpy(output, result.c_str());
+									time_service.getTime(output, TimeService::UTC);
 								}
 								else if (tokens[1] == "LOCK")
 								{
@@ -1161,6 +1907,18 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 								{
 									std::strcpy(output, EXTDB_VERSION);
 								}
+								else if (tokens[1] == "RESULT_STATS")
+								{
+									getResultStats(output);
+								}
+								else if (tokens[1] == "QUEUE_DEPTH")
+								{
+									getQueueDepth(output, output_size);
+								}
+								else if (tokens[1] == "METRICS")
+								{
+									getMetrics(output, output_size);
+								}
 								else if (tokens[1] == "OUTPUTSIZE")
 								{
 									std::string outputsize_str(std::to_string(output_size));
@@ -1170,37 +1928,38 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 								else
 								{
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB3: Error Invalid Format: {0}", input_str);
+									logger->error("extDB3: Error Invalid Format: {0}", function);
 								}
 								break;
 							case 3:
 								if (tokens[1] == "UPTIME")
 								{
-									std::string result;
-									getUPTime(tokens[2], result);
-									std::strcpy(output, result.c_str());
+									if (!time_service.getUPTime(output, tokens[2], false))
+									{
+										logger->info("extDB3: UPTIME: invalid input: {0}", function);
+									}
 								}
 								else if (tokens[1] == "LOCAL_TIME")
 								{
-									std::string result;
-									getLocalTime(tokens[2], result);
-									std::strcpy(output, result.c_str());
+									time_service.getTime(output, TimeService::LOCAL, tokens[2]);
 								}
 								else if (tokens[1] == "UTC_TIME")
 								{
-									std::string result;
-									getUTCTime(tokens[2], result);
-									std::strcpy(output, result.c_str());
+									time_service.getTime(output, TimeService::UTC, tokens[2]);
+								}
+								else if (tokens[1] == "PROTOCOL_HANDLE")
+								{
+									getProtocolHandle(output, tokens[2]);
 								}
 								// DATABASE
 								else if (tokens[1] == "ADD_DATABASE")
 								{
-									connectDatabase(output, tokens[2], tokens[2]);
+									connectDatabase(output, std::string(tokens[2]), std::string(tokens[2]));
 								}
 								else if (tokens[1] == "LOCK")
 								{
 									ext_info.extDB_lock = true;
-									ext_info.extDB_lockCode = tokens[2];
+									ext_info.extDB_lockCode = std::string(tokens[2]);
 									std::strcpy(output, ("[1]"));
 									logger->info("extDB3: Locked");
 								}
@@ -1208,64 +1967,65 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 								{
 									// Invalid Format
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB3: Error Invalid Format: {0}", input_str);
+									logger->error("extDB3: Error Invalid Format: {0}", function);
 								}
 								break;
 							case 4:
 								if (tokens[1] == "ADD_DATABASE")
 								{
-									connectDatabase(output, tokens[2], tokens[3]);
+									connectDatabase(output, std::string(tokens[2]), std::string(tokens[3]));
 								}
 								else if (tokens[1] == "ADD_PROTOCOL")
 								{
-									addProtocol(output, "", tokens[2], tokens[3], "");
+									addProtocol(output, "", std::string(tokens[2]), std::string(tokens[3]), "");
 								}
 								else if (tokens[1] == "DATEADD")
 								{
-									std::string result;
-									getDateAdd(tokens[2],tokens[3],result);
-									std::strcpy(output, result.c_str());
+									if (!time_service.getDateAdd(output, tokens[2], tokens[3]))
+									{
+										logger->info("extDB3: DATEADD: invalid input: {0}", function);
+									}
 								}
 								else
 								{
 									// Invalid Format
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB3: Error Invalid Format: {0}", input_str);
+									logger->error("extDB3: Error Invalid Format: {0}", function);
 								}
 								break;
 							case 5:
 								if (tokens[1] == "ADD_PROTOCOL")
 								{
-									addProtocol(output, "", tokens[2], tokens[3], tokens[4]); // ADD + Init Options
+									addProtocol(output, "", std::string(tokens[2]), std::string(tokens[3]), std::string(tokens[4])); // ADD + Init Options
 								}
 								else if (tokens[1] == "ADD_DATABASE_PROTOCOL")
 								{
-									addProtocol(output, tokens[2], tokens[3], tokens[4], ""); // ADD Database Protocol + No Options
+									addProtocol(output, std::string(tokens[2]), std::string(tokens[3]), std::string(tokens[4]), ""); // ADD Database Protocol + No Options
 								}
 								else
 								{
 									// Invalid Format
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB3: Error Invalid Format: {0}", input_str);
+									logger->error("extDB3: Error Invalid Format: {0}", function);
 								}
 								break;
 							case 6:
 								if (tokens[1] == "ADD_DATABASE_PROTOCOL")
 								{
-									addProtocol(output, tokens[2], tokens[3], tokens[4], tokens[5]); // ADD Database Protocol + Options
+									addProtocol(output, std::string(tokens[2]), std::string(tokens[3]), std::string(tokens[4]), std::string(tokens[5])); // ADD Database Protocol + Options
 								}
 								else
 								{
 									// Invalid Format
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB3: Error Invalid Format: {0}", input_str);
+									logger->error("extDB3: Error Invalid Format: {0}", function);
 								}
 								break;
 							default:
 								{
 									// Invalid Format
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB3: Error Invalid Format: {0}", input_str);
+									logger->error("extDB3: Error Invalid Format: {0}", function);
 								}
 						}
 					}
@@ -1274,7 +2034,133 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 				default:
 				{
 					std::strcpy(output, "[0,\"Error Invalid Message\"]");
-					logger->error("extDB3: Error Invalid Message: {0}", input_str);
+					logger->error("extDB3: Error Invalid Message: {0}", function);
+				}
+			}
+		}
+		#ifdef DEBUG_LOGGING
+			logger->info("extDB3: Output to Server: {0}", output);
+		#endif
+	}
+	catch (spdlog::spdlog_ex& e)
+	{
+		std::strcpy(output, "[0,\"Error LOGGER\"]");
+		std::cout << "SPDLOG ERROR: " <<  e.what() << std::endl;
+	}
+}
+
+
+void Ext::callExtension(char *output, const int &output_size, const char *function, const char **args, const int &args_size)
+// RVExtensionArgs
+//   function = Mode,  args[0] = Protocol Name / Unique ID,  args[1..] = Protocol Inputs
+//   Inputs are passed straight to the Protocol, no string concat / split
+{
+	try
+	{
+		#ifdef DEBUG_LOGGING
+			logger->info("extDB3: Input from Server: {0} Args: {1}", std::string(function), args_size);
+		#endif
+
+		if ((function[0] == '\0') || (function[1] != '\0') || (args_size < 1))
+		{
+			std::strcpy(output, "[0,\"Error Invalid Message\"]");
+			logger->info("extDB3: Invalid Message: {0} Args: {1}", std::string(function), args_size);
+		}
+		else
+		{
+			if ((function[0] >= '0') && (function[0] <= '9'))
+			{
+				metrics_calls[function[0] - '0'].fetch_add(1, std::memory_order_relaxed);
+			}
+
+			switch (function[0])
+			{
+				case '0': //SYNC
+				case '1': //ASYNC
+				case '2': //ASYNC + SAVE
+				case '3': //ASYNC + SAVE + CALLBACK
+				{
+					if (args_size < 2)
+					{
+						std::strcpy(output, "[0,\"Error Invalid Format\"]");
+						logger->error("extDB3: Error Invalid Format: {0} Args: {1}", std::string(function), args_size);
+						break;
+					}
+					if ((function[0] == '3') && (callback_ptr.load(std::memory_order_acquire) == nullptr))
+					{
+						std::strcpy(output, "[0,\"Error Callback Not Registered\"]");
+						logger->error("extDB3: Error Callback Not Registered");
+						break;
+					}
+					const std::string_view protocol_name = getArgView(args[0]);
+					protocol_struct *protocol_data = findProtocol(protocol_name);
+					if (!protocol_data)
+					{
+						std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
+						logger->error("extDB3: Error Unknown Protocol: {0}", std::string(protocol_name));
+						break;
+					}
+
+					std::vector<std::string> tokens;
+					tokens.reserve(args_size - 1);
+					for (int i = 1; i < args_size; ++i)
+					{
+						tokens.push_back(getArg(args[i]));
+					}
+
+					if (function[0] == '0')
+					{
+						syncCallProtocolArgs(output, output_size, protocol_data, tokens);
+					}
+					else if (function[0] == '1')
+					{
+						if (!protocol_data->lane->submit([this, protocol_data, tokens = std::move(tokens)]() mutable { onewayCallProtocolArgs(protocol_data, tokens); }))
+						{
+							std::strcpy(output, "[0,\"Error Queue Full\"]");
+						}
+					}
+					else
+					{
+						const unsigned long unique_id = stored_results.reserve();
+						if (unique_id == 0)
+						{
+							std::strcpy(output, "[0,\"Error Result Store Full\"]");
+							logger->error("extDB3: Error Result Store Full");
+						}	else {
+							const bool callback = (function[0] == '3');
+							protocol_data->lane->post([this, output_size, protocol_data, tokens = std::move(tokens), unique_id, callback]() mutable { asyncCallProtocolArgs(output_size, protocol_data, tokens, unique_id, callback); });
+							std::strcpy(output, ("[2,\"" + std::to_string(unique_id) + "\"]").c_str());
+						}
+					}
+					break;
+				}
+				case '4': // GET -- Single-Part Message Format
+				{
+					const unsigned long unique_id = strtoul(getArgView(args[0]).data(), NULL, 0);
+					getSinglePartResult(output, output_size, unique_id);
+					break;
+				}
+				case '5': // GET -- Multi-Part Message Format
+				{
+					const unsigned long unique_id = strtoul(getArgView(args[0]).data(), NULL, 0);
+					getMultiPartResult(output, output_size, unique_id);
+					break;
+				}
+				case '6': // GET -- Batch of Unique IDs
+				{
+					std::vector<unsigned long> unique_ids;
+					unique_ids.reserve(args_size);
+					for (int i = 0; i < args_size; ++i)
+					{
+						unique_ids.push_back(strtoul(getArgView(args[i]).data(), NULL, 0));
+					}
+					getBatchResults(output, output_size, unique_ids);
+					break;
+				}
+				default:
+				{
+					std::strcpy(output, "[0,\"Error Invalid Message\"]");
+					logger->error("extDB3: Error Invalid Message: {0} Args: {1}", std::string(function), args_size);
 				}
 			}
 		}
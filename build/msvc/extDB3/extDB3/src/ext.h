@@ -5,7 +5,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <string_view>
 #include <thread>
 #include <unordered_map>
 
@@ -18,6 +20,10 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include "abstract_ext.h"
+#include "executor.h"
+#include "metrics.h"
+#include "results.h"
+#include "time_service.h"
 
 #include "protocols/abstract_protocol.h"
 
@@ -30,12 +36,31 @@ public:
 	void reset();
 	void stop();
 	void idleCleanup(const boost::system::error_code& ec);
+	void resultCleanup(const boost::system::error_code& ec);
+	void pushRetry(const boost::system::error_code& ec);
+	void metricsDump(const boost::system::error_code& ec);
+	void lanesAdjust(const boost::system::error_code& ec);
 	void callExtension(char *output, const int &output_size, const char *function);
+	void callExtension(char *output, const int &output_size, const char *function, const char **args, const int &args_size);
+
+	// Arma Extension Callback
+	typedef int (*callback_function)(char const *name, char const *function, char const *data);
+	void registerCallback(callback_function callback);
 
 	struct protocol_struct
 	{
 		std::string													name;
 		std::unique_ptr<AbstractProtocol>		protocol;
+		Executor														*lane;
+		MetricsHistogram										latency;
+	};
+
+	struct protocol_registry
+	// Immutable Snapshot, ADD_PROTOCOL publishes a new copy. Handle == index into protocols
+	//   Keys view protocol_struct::name, protocols are shared between Snapshots so the Keys stay valid
+	{
+		std::vector<std::shared_ptr<protocol_struct>>		protocols;
+		std::unordered_map<std::string_view, std::size_t>		handles;
 	};
 
 
@@ -46,59 +71,100 @@ private:
 	// Input
 	std::string::size_type input_str_length;
 
-	// Main ASIO Thread Queue
-	std::unique_ptr<boost::asio::io_service::work> io_work_ptr;
-	boost::asio::io_service io_service;
-	boost::thread_group threads;
+	// Execution Lanes
+	//   Default Lane runs Protocols not assigned to a Lane
+	std::unordered_map<std::string, std::unique_ptr<Executor>> lanes;
+	std::unordered_map<std::string, Executor *> lanes_protocols;  // Protocol Name -> Lane
+	Executor *default_lane = nullptr;
+
+	// Timers -- Own Thread, never queue behind Protocol Calls
+	boost::asio::io_service timer_service;
+	std::unique_ptr<boost::asio::io_service::work> timer_work_ptr;
+	boost::thread timer_thread;
+
+	// Guards mariadb_databases insert / erase (Game Thread) against iteration on Timer Thread
+	std::mutex mutex_mariadb_databases;
 
 	std::mutex mutex_mariadb_idle_cleanup_timer;
 	std::unique_ptr<boost::asio::deadline_timer> mariadb_idle_cleanup_timer;
+	std::atomic<bool> mariadb_idle_cleanup_running{false};  // Health Check runs on Default Lane, skip tick if previous still running
+
+	std::mutex mutex_result_cleanup_timer;
+	std::unique_ptr<boost::asio::deadline_timer> result_cleanup_timer;
+	int result_cleanup_interval = 0;
+
+	std::mutex mutex_lanes_adjust_timer;
+	std::unique_ptr<boost::asio::deadline_timer> lanes_adjust_timer;
+
+	// Metrics
+	std::atomic<std::uint64_t> metrics_calls[10] = {};  // Calls per Mode
+	std::shared_ptr<spdlog::logger> metrics_logger;
+	std::mutex mutex_metrics_dump_timer;
+	std::unique_ptr<boost::asio::deadline_timer> metrics_dump_timer;
+	int metrics_dump_interval = 0;
 
 	// Protocols
-	std::vector<protocol_struct> vec_protocols;
-	std::mutex mutex_vec_protocols;
+	//   Readers load the current snapshot without locking, old snapshots are only freed after worker threads are stopped
+	std::atomic<const protocol_registry *> protocols_registry{nullptr};
+	std::vector<std::unique_ptr<const protocol_registry>> protocols_registry_snapshots;
+	std::mutex mutex_protocols_registry;
 
 	// Unique ID
 	std::string::size_type call_extension_input_str_length;
-	unsigned long unique_id_counter = 100; // Can't be value 1
-
-	// Results
-	std::unordered_map<unsigned long, resultData> stored_results;
-	std::mutex mutex_results;  // Using Same Lock for Unique ID aswell
-
-	// UPTimer
-	std::chrono::time_point<std::chrono::steady_clock> uptime_start;
-	std::chrono::time_point<std::chrono::steady_clock> uptime_current;
-	
-	// Clock
-	boost::posix_time::ptime ptime;
-	boost::posix_time::time_facet *facet;
-	
-	boost::posix_time::time_facet *facet_localtime;
+
+	// Results -- Lock-free, Unique ID generated by ResultStore
+	ResultStore stored_results;
+
+	// Callback -- ASYNC + CALLBACK pushes results instead of SQF polling
+	std::atomic<callback_function> callback_ptr{nullptr};
+	//   Callback Queue Full, push is retried on next push + every second on Timer Thread, until delivered / result is evicted
+	std::mutex mutex_push_retry;
+	std::vector<std::pair<unsigned long, int>> push_retry_ids;  // Unique ID, output_size
+	std::unique_ptr<boost::asio::deadline_timer> push_retry_timer;
+	bool push_retry_armed = false;
+
+	// LOCAL_TIME / UTC_TIME / DATEADD / UPTIME
+	TimeService time_service;
 
 	void search(boost::filesystem::path &extDB_config_path, bool &conf_found, bool &conf_randomized);
+	void setupLanes();
+	void startTimerService();
+	void startLanesAdjust();
+	void getQueueDepth(char *output, const int &output_size);
+	void startMetricsDump();
+	void getMetrics(std::string &result);
+	void getMetrics(char *output, const int &output_size);
 
 	void connectDatabase(char *output, const std::string &database_conf, const std::string &database_id);
 
 	// Protocols
 	void addProtocol(char *output, const std::string &database_id, const std::string &protocol, const std::string &protocol_name, const std::string &init_data);
-	void getSinglePartResult_mutexlock(char *output, const int &output_size, const unsigned long &unique_id);
-	void getMultiPartResult_mutexlock(char *output, const int &output_size, const unsigned long &unique_id);
-	void syncCallProtocol(char *output, const int &output_size, std::string &input_str);
-	void onewayCallProtocol(std::string &input_str);
-	void asyncCallProtocol(const int &output_size, const std::string &protocol_name, const std::string &data, const unsigned long unique_id);
-
-	const unsigned long saveResult_mutexlock(const resultData &result_data);
-	void saveResult_mutexlock(const unsigned long &unique_id, const resultData &result_data);
-	void saveResult_mutexlock(std::vector<unsigned long> &unique_ids, const resultData &result_data);
-
-	void getUPTime(std::string &token, std::string &result);
-	void getUPTime2(std::string &token, std::string &result);
-	void getLocalTime(std::string &result);
-	void getLocalTime(std::string &input_str, std::string &result);
-	void getUTCTime(std::string &result);
-	void getUTCTime(std::string &input_str, std::string &result);
-	
-	void getDateAdd(std::string &token, std::string &token2, std::string &result);
+	void getProtocolHandle(char *output, std::string_view protocol_name);
+	protocol_struct *findProtocol(std::string_view protocol_name);
+	void getSinglePartResult(char *output, const int &output_size, const unsigned long &unique_id);
+	void getMultiPartResult(char *output, const int &output_size, const unsigned long &unique_id);
+	void getBatchResults(char *output, const int &output_size, const std::vector<unsigned long> &unique_ids);
+	void syncCallProtocol(char *output, const int &output_size, std::string_view input_str);
+	void onewayCallProtocol(protocol_struct *protocol_data, std::string &data);
+	void asyncCallProtocol(const int &output_size, protocol_struct *protocol_data, std::string &data, const unsigned long unique_id, const bool callback);
+
+	void syncCallProtocolArgs(char *output, const int &output_size, protocol_struct *protocol_data, std::vector<std::string> &tokens);
+	void onewayCallProtocolArgs(protocol_struct *protocol_data, std::vector<std::string> &tokens);
+	void asyncCallProtocolArgs(const int &output_size, protocol_struct *protocol_data, std::vector<std::string> &tokens, const unsigned long unique_id, const bool callback);
+
+	const unsigned long saveResult(resultData &result_data);
+	void saveResult(const unsigned long &unique_id, resultData &result_data);
+	void saveResult(std::vector<unsigned long> &unique_ids, const resultData &result_data);
+	unsigned long saveResultStream(const unsigned long &unique_id, std::unique_ptr<ResultStream> &&stream);
+	void releaseStream(ResultStore::slot *slot_ptr, const int &output_size);
+	void postStreamPart(ResultStore::slot *slot_ptr, const int &output_size);
+	bool waitStreamPart(ResultStore::slot *slot_ptr, const int &output_size);
+	void buildStreamPart(ResultStore::slot *slot_ptr, const int output_size);
+	void startResultCleanup();
+	void getResultStats(char *output);
+	void pushResult(const int &output_size, const unsigned long &unique_id);
+	bool tryPushResult(const int &output_size, const unsigned long &unique_id);
+	void retryPushResults();
+	void armPushRetry();
 
 };
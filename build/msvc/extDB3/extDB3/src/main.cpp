@@ -36,6 +36,7 @@ Ext *extension;
 		void RVExtension(char *output, int outputSize, const char *function);
 		void RVExtensionVersion(char* output, int outputSize);
 		int RVExtensionArgs(char* output, int outputSize, const char* function, const char** argv, int argc);
+		void RVExtensionRegisterCallback(int(*callbackProc)(char const *name, char const *function, char const *data));
 	};
 
 	void RVExtension(char *output, int outputSize, const char *function)
@@ -45,10 +46,15 @@ Ext *extension;
 	};
 
 	int RVExtensionArgs(char* output, int outputSize, const char* function, const char** argv, int argc) {
-		std::strncpy(output, "not supported", outputSize - 1);
+		outputSize -= 1;
+		extension->callExtension(output, outputSize, function, argv, argc);
 		return 0;
 	}
 
+	void RVExtensionRegisterCallback(int(*callbackProc)(char const *name, char const *function, char const *data)) {
+		extension->registerCallback(callbackProc);
+	}
+
 	void RVExtensionVersion(char* output, int outputSize) {
 		std::strncpy(output, "extDB3 v1033 Linux", outputSize - 1);
 	}
@@ -93,6 +99,7 @@ Ext *extension;
 		__declspec(dllexport) void __stdcall RVExtension(char *output, int outputSize, const char *function);
 		__declspec(dllexport) int __stdcall RVExtensionArgs(char* output, int outputSize, const char* function, const char** argv, int argc);
 		__declspec(dllexport) void __stdcall RVExtensionVersion(char* output, int outputSize);
+		__declspec(dllexport) void __stdcall RVExtensionRegisterCallback(int(*callbackProc)(char const *name, char const *function, char const *data));
 	};
 
 	void __stdcall RVExtension(char *output, int outputSize, const char *function) {
@@ -100,11 +107,16 @@ Ext *extension;
 		extension->callExtension(output, outputSize, function);
 	};
 
-	int RVExtensionArgs(char* output, int outputSize, const char* function, const char** argv, int argc) {
-		std::strncpy(output, "not supported", outputSize - 1);
+	int __stdcall RVExtensionArgs(char* output, int outputSize, const char* function, const char** argv, int argc) {
+		outputSize -= 1;
+		extension->callExtension(output, outputSize, function, argv, argc);
 		return 0;
 	}
 
+	void __stdcall RVExtensionRegisterCallback(int(*callbackProc)(char const *name, char const *function, char const *data)) {
+		extension->registerCallback(callbackProc);
+	}
+
 	void RVExtensionVersion(char* output, int outputSize) {
 		std::strncpy(output, "extDB3 v1033 Windows", outputSize - 1);
 	}
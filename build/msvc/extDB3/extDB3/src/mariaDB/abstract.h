@@ -23,6 +23,10 @@ struct sql_option
 
 	bool mysql_escape = false;
 
+	// INPUT only, Prepared Statements bind the parsed value instead of a String
+	enum NativeType { NATIVE_NONE, NATIVE_INT, NATIVE_BIGINT, NATIVE_DOUBLE, NATIVE_BOOL };
+	int native_type = NATIVE_NONE;
+
 	bool strip = false;
 
 	int value_number = -1;
@@ -8,6 +8,7 @@
 #include <iostream>
 
 #include "exceptions.h"
+#include "../metrics.h"
 
 
 MariaDBConnector::MariaDBConnector()
@@ -45,6 +46,7 @@ void MariaDBConnector::connect()
 	//mysql_optionsv(mysql_ptr, MYSQL_OPT_CONNECT_TIMEOUT, (const char *)5);
 	mysql_optionsv(mysql_ptr, MYSQL_OPT_RECONNECT, (void *)"1");
 	mysql_optionsv(mysql_ptr, MYSQL_SET_CHARSET_NAME, (void *)"utf8");
+	MetricsBlockedScope blocked;
 	if (!(mysql_real_connect(mysql_ptr, login_data.host.c_str(), login_data.user.c_str(), login_data.password.c_str(), login_data.db.c_str(), login_data.port, 0, 0)))
 	{
 		throw MariaDBConnectorException(mysql_ptr);
@@ -23,6 +23,19 @@ private:
 };
 
 
+class MariaDBPoolException: public std::exception
+{
+public:
+	MariaDBPoolException(std::string msg) : msg(msg) {}
+	virtual const char* what() const throw()
+	{
+		return msg.c_str();
+	}
+private:
+	std::string msg;
+};
+
+
 class MariaDBConnectorException: public std::exception
 {
 public:
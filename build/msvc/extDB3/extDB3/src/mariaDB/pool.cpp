@@ -5,10 +5,16 @@
 
 #include "pool.h"
 
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
 #include <boost/bind.hpp>
 #include <mariadb/mysql.h>
 
 #include "connector.h"
+#include "exceptions.h"
 
 
 
@@ -22,7 +28,7 @@ MariaDBPool::~MariaDBPool(void)
 }
 
 
-void MariaDBPool::init(std::string &host, unsigned int &port, std::string &user, std::string &password, std::string &db)
+void MariaDBPool::init(std::string &host, unsigned int &port, std::string &user, std::string &password, std::string &db, const pool_options &options)
 {
 	login_data.host = host;
 	login_data.port = port;
@@ -30,66 +36,303 @@ void MariaDBPool::init(std::string &host, unsigned int &port, std::string &user,
 	login_data.password = password;
 	login_data.db = db;
 
-	putBack(get()); // Force Start MySQL Connection + Return MySQL Connection Back to Idle
+	max_sessions = options.max_connections;
+	acquire_timeout = std::chrono::milliseconds(std::max(options.acquire_timeout, 0));
+	idle_timeout = boost::posix_time::seconds(std::max(options.idle_timeout, 0));
+	thread_affinity = options.thread_affinity;
+	min_sessions = std::max(options.min_connections, 1);
+	if (max_sessions > 0)
+	{
+		min_sessions = std::min(min_sessions, max_sessions);
+	}
+	// Database wide, shared by every Session through statement_metrics (Max Connections can be Unlimited)
+	statement_capacity = static_cast<std::size_t>(std::max(options.max_prepared_statements, 0));
+
+	// Prewarm, Handshakes run in parallel. Any failure fails ADD_DATABASE, same as before
+	std::vector<std::unique_ptr<mariadb_session_struct>> sessions(min_sessions);
+	std::vector<std::exception_ptr> errors(min_sessions);
+	std::vector<std::thread> threads;
+	live_sessions += min_sessions;
+	for (int i = 1; i < min_sessions; ++i)
+	{
+		threads.emplace_back([this, i, &sessions, &errors]()
+		{
+			try
+			{
+				sessions[i] = createSession();
+			}
+			catch (...)
+			{
+				errors[i] = std::current_exception();
+			}
+		});
+	}
+	try
+	{
+		sessions[0] = createSession();
+	}
+	catch (...)
+	{
+		errors[0] = std::current_exception();
+	}
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+
+	for (int i = 0; i < min_sessions; ++i)
+	{
+		if (sessions[i])
+		{
+			putBack(std::move(sessions[i]));
+		} else {
+			--live_sessions;
+		}
+	}
+	for (auto &error : errors)
+	{
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
 }
 
 
-std::unique_ptr<MariaDBPool::mariadb_session_struct> MariaDBPool::get()
+std::unique_ptr<MariaDBPool::mariadb_session_struct> MariaDBPool::createSession()
+{
+	std::unique_ptr<mariadb_session_struct> mariadb_session(new mariadb_session_struct());
+	mariadb_session->connector.init(login_data.host, login_data.port, login_data.user, login_data.password, login_data.db);
+	mariadb_session->connector.connect();
+	mariadb_session->query.init(mariadb_session->connector);
+	mariadb_session->statements.init(statement_capacity, &statement_metrics);
+	return mariadb_session;
+}
+
+
+std::unique_ptr<MariaDBPool::mariadb_session_struct> MariaDBPool::connectSession(const std::chrono::steady_clock::time_point &start)
+// Slot already reserved in live_sessions, connects without pool lock held
 {
 	std::unique_ptr<mariadb_session_struct> mariadb_session;
+	try
+	{
+		mariadb_session = createSession();
+		mariadb_session->owner = std::this_thread::get_id();
+	}
+	catch (...)
 	{
 		std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
-		if (mariadb_session_pool.size() > 0)
+		releaseSlot();
+		throw;
+	}
+	wait_metrics.record(start);
+	return mariadb_session;
+}
+
+
+void MariaDBPool::releaseSlot()
+{
+	if (waiters.empty())
+	{
+		--live_sessions;
+	} else {
+		// Slot passes to oldest waiter, live_sessions unchanged
+		waiter_struct *waiter = waiters.front();
+		waiters.pop_front();
+		waiter->connect = true;
+		waiter->cv.notify_one();
+	}
+}
+
+
+std::unique_ptr<MariaDBPool::mariadb_session_struct> MariaDBPool::get()
+// Idle Session -> New Session (connected outside the lock) -> FIFO wait for putBack when at Max Connections
+{
+	const auto start = std::chrono::steady_clock::now();
+	MetricsBlockedScope blocked;
+	std::unique_lock<std::mutex> lock(mariadb_session_pool_mutex);
+	if (!mariadb_session_pool.empty())
+	{
+		auto session_itr = mariadb_session_pool.begin();
+		if (thread_affinity)
 		{
-			mariadb_session = std::move(mariadb_session_pool.front());
-			mariadb_session_pool.pop_front();
-		} else {
-			mariadb_session.reset(new mariadb_session_struct());
-			mariadb_session->connector.init(login_data.host, login_data.port, login_data.user, login_data.password, login_data.db);
-			mariadb_session->connector.connect();
-			mariadb_session->query.init(mariadb_session->connector);
+			const std::thread::id thread_id = std::this_thread::get_id();
+			auto owned_itr = std::find_if(mariadb_session_pool.begin(), mariadb_session_pool.end(),
+				[&thread_id](const std::unique_ptr<mariadb_session_struct> &session) { return session->owner == thread_id; });
+			if (owned_itr != mariadb_session_pool.end())
+			{
+				session_itr = owned_itr;
+				++affinity_hits;
+			} else {
+				// Least recently used Session, its owner (if any) is the least active. Claim it
+				(*session_itr)->owner = thread_id;
+				++affinity_misses;
+			}
 		}
+		std::unique_ptr<mariadb_session_struct> mariadb_session = std::move(*session_itr);
+		mariadb_session_pool.erase(session_itr);
+		lock.unlock();
+		wait_metrics.record(start);
+		return mariadb_session;
 	}
-	return mariadb_session;
+	if ((max_sessions <= 0) || (live_sessions.load() < max_sessions))
+	{
+		// Reserve the slot, other threads keep using the pool while this one connects
+		++live_sessions;
+		lock.unlock();
+		return connectSession(start);
+	}
+
+	waiter_struct waiter;
+	waiters.push_back(&waiter);
+	const auto deadline = start + acquire_timeout;
+	while ((!waiter.mariadb_session) && (!waiter.connect))
+	{
+		if (acquire_timeout.count() <= 0)
+		{
+			waiter.cv.wait(lock);
+		}
+		else if ((waiter.cv.wait_until(lock, deadline) == std::cv_status::timeout) && (!waiter.mariadb_session) && (!waiter.connect))
+		{
+			waiters.erase(std::find(waiters.begin(), waiters.end(), &waiter));
+			++acquire_timeouts;
+			lock.unlock();
+			wait_metrics.record(start);
+			throw MariaDBPoolException("Acquire Timeout: " + std::to_string(acquire_timeout.count()) + "ms");
+		}
+	}
+	lock.unlock();
+	if (waiter.connect)
+	{
+		return connectSession(start);
+	}
+	wait_metrics.record(start);
+	return std::move(waiter.mariadb_session);
 }
 
 
 void MariaDBPool::putBack(std::unique_ptr<mariadb_session_struct> mariadb_session)
 {
 	mariadb_session->last_used = boost::posix_time::second_clock::local_time();
+	std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+	if (waiters.empty())
 	{
-		std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
 		mariadb_session_pool.push_back(std::move(mariadb_session));
+	} else {
+		waiter_struct *waiter = waiters.front();
+		waiters.pop_front();
+		waiter->mariadb_session = std::move(mariadb_session);
+		waiter->cv.notify_one();
 	}
 }
 
 
 void MariaDBPool::idleCleanup()
+// Pool is ordered by last_used, oldest at the front (get pops front, putBack pushes back)
 {
-	auto tick = boost::posix_time::second_clock::local_time();
-	boost::posix_time::time_duration diff;
-	std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+	const auto tick = boost::posix_time::second_clock::local_time();
+	const std::uint64_t health_check = ++health_checks;
+	std::list<std::unique_ptr<mariadb_session_struct>> closed_sessions;
 	{
-		// Remove old connections (10 Minutes)
-		for(auto session_itr = mariadb_session_pool.end(); session_itr != mariadb_session_pool.begin(); --session_itr) {
-			diff = tick - (*session_itr)->last_used;
-			if (diff.total_seconds() > 600)
+		std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+		// Trim Sessions idle longer than Idle Timeout, down to Min Connections
+		while ((!mariadb_session_pool.empty()) && (live_sessions.load() > min_sessions) &&
+			((tick - mariadb_session_pool.front()->last_used) > idle_timeout))
+		{
+			closed_sessions.push_back(std::move(mariadb_session_pool.front()));
+			mariadb_session_pool.pop_front();
+			releaseSlot();
+		}
+	}
+	closed_sessions.clear(); // mysql_close outside the lock
+
+	// Ping idle Sessions one at a time, rest of the pool stays usable meanwhile
+	while (true)
+	{
+		std::unique_ptr<mariadb_session_struct> mariadb_session;
+		{
+			std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+			auto session_itr = std::find_if(mariadb_session_pool.begin(), mariadb_session_pool.end(),
+				[health_check](const std::unique_ptr<mariadb_session_struct> &session) { return session->health_check != health_check; });
+			if (session_itr == mariadb_session_pool.end())
 			{
-				mariadb_session_pool.erase(mariadb_session_pool.begin(), session_itr);
 				break;
-			};
+			}
+			mariadb_session = std::move(*session_itr);
+			mariadb_session_pool.erase(session_itr);
 		}
-		// Ping any connections still alive, Reconnect & Wipe Statements if Required
-		for(auto session_itr = mariadb_session_pool.begin(); session_itr != mariadb_session_pool.end(); ++session_itr) {
-			auto original_thread_id = mysql_thread_id((*session_itr)->connector.mysql_ptr);
-			if (mysql_ping((*session_itr)->connector.mysql_ptr))
+		mariadb_session->health_check = health_check;
+
+		const auto original_thread_id = mysql_thread_id(mariadb_session->connector.mysql_ptr);
+		if (mysql_ping(mariadb_session->connector.mysql_ptr) != 0)
+		{
+			// Connection Lost + Reconnect failed
+			mariadb_session.reset();
+			std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+			releaseSlot();
+			continue;
+		}
+		if (original_thread_id != mysql_thread_id(mariadb_session->connector.mysql_ptr))
+		{
+			// Reconnected, Prepared Statements are gone
+			mariadb_session->statements.clear();
+		}
+
+		std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+		if (waiters.empty())
+		{
+			// Keeps its last_used, so idle trimming still sees it
+			auto session_itr = std::find_if(mariadb_session_pool.begin(), mariadb_session_pool.end(),
+				[&mariadb_session](const std::unique_ptr<mariadb_session_struct> &session) { return session->last_used > mariadb_session->last_used; });
+			mariadb_session_pool.insert(session_itr, std::move(mariadb_session));
+		} else {
+			waiter_struct *waiter = waiters.front();
+			waiters.pop_front();
+			waiter->mariadb_session = std::move(mariadb_session);
+			waiter->cv.notify_one();
+		}
+	}
+
+	// Reopen lost Sessions up to Min Connections
+	while (true)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+			if (live_sessions.load() >= min_sessions)
 			{
-				if ((original_thread_id) != mysql_thread_id((*session_itr)->connector.mysql_ptr))
-				{
-					(*session_itr)->statements.clear();
-					mysql_reset_connection((*session_itr)->connector.mysql_ptr);
-				};
-			};
+				break;
+			}
+			++live_sessions;
+		}
+		try
+		{
+			putBack(createSession());
+		}
+		catch (MariaDBConnectorException &)
+		{
+			std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+			releaseSlot();
+			break; // Database down, retry next Health Check
 		}
 	}
 }
+
+
+std::size_t MariaDBPool::getIdleSessions()
+{
+	std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+	return mariadb_session_pool.size();
+}
+
+
+std::size_t MariaDBPool::getWaiting()
+{
+	std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+	return waiters.size();
+}
+
+
+std::size_t MariaDBPool::getStatementCapacity()
+{
+	return statement_capacity;
+}
@@ -5,9 +5,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
 
 #include <boost/asio.hpp>
@@ -16,6 +20,8 @@
 #include "connector.h"
 #include "query.h"
 #include "statement.h"
+#include "statement_cache.h"
+#include "../metrics.h"
 
 
 class MariaDBPool
@@ -27,16 +33,41 @@ public:
 	struct mariadb_session_struct
 	{
 		boost::posix_time::ptime last_used;
+		std::uint64_t health_check = 0;  // Last idleCleanup run that pinged this Session
+		std::thread::id owner;           // Thread Affinity, Worker Thread this Session prefers
 		MariaDBConnector connector;
 		MariaDBQuery     query;
-		std::unordered_map<std::string, std::vector<MariaDBStatement> > statements;
+		MariaDBStatementCache statements;  // Declared after connector, so Statements are closed before the Connection
 	};
 
-	void init(std::string &host, unsigned int &port, std::string &user, std::string &password, std::string &db);
-	std::unique_ptr<mariadb_session_struct> get();
+	struct pool_options
+	{
+		int min_connections = 1;     // Opened in parallel at init, never trimmed
+		int max_connections = 0;     // <= 0 = Unlimited
+		int acquire_timeout = 10000; // Milliseconds, only applies once max_connections is reached, <= 0 = Wait Forever
+		int idle_timeout = 600;      // Seconds, Sessions above min_connections idle longer are closed
+		bool thread_affinity = false; // Worker Threads get their own Session back, so its Prepared Statements are reused
+		int max_prepared_statements = 0; // Budget shared by all Sessions, <= 0 = Unlimited
+	};
+
+	void init(std::string &host, unsigned int &port, std::string &user, std::string &password, std::string &db, const pool_options &options);
+	std::unique_ptr<mariadb_session_struct> get();  // Throws MariaDBPoolException on Acquire Timeout
 	void putBack(std::unique_ptr<mariadb_session_struct> mariadb_session);
+
+	// Health Check, Sessions are taken out of the pool one at a time so get() / putBack() never wait on a ping
 	void idleCleanup();
 
+	// Metrics
+	MetricsHistogram wait_metrics;           // Time spent in get(), includes new connections
+	std::atomic<int> live_sessions{0};      // Includes Sessions still connecting
+	std::atomic<std::uint64_t> acquire_timeouts{0};
+	std::atomic<std::uint64_t> affinity_hits{0};    // Thread Affinity, got own Session back
+	std::atomic<std::uint64_t> affinity_misses{0};  // Thread Affinity, own Session busy / closed
+	MariaDBStatementCache::cache_metrics statement_metrics;
+	std::size_t getStatementCapacity();  // Database wide, 0 = Unlimited
+	std::size_t getIdleSessions();
+	std::size_t getWaiting();
+
 private:
 	struct login_data_struct
 	{
@@ -48,6 +79,28 @@ private:
 	};
 	login_data_struct login_data;
 
+	int min_sessions = 1;
+	int max_sessions = 0;
+	std::chrono::milliseconds acquire_timeout{0};
+	boost::posix_time::seconds idle_timeout{600};
+	bool thread_affinity = false;
+	std::size_t statement_capacity = 0;
+	std::uint64_t health_checks = 0;  // idleCleanup runs, never overlap (Ext::idleCleanup skips a tick while one is running)
+
+	// Threads waiting at Max Connections, served FIFO
+	//   putBack hands its Session straight to the oldest waiter, so a new get() can never jump the queue
+	struct waiter_struct
+	{
+		std::condition_variable cv;
+		std::unique_ptr<mariadb_session_struct> mariadb_session;
+		bool connect = false;  // Slot freed up, waiter opens a new connection
+	};
+	std::deque<waiter_struct *> waiters;
+
 	std::list<std::unique_ptr<mariadb_session_struct>> mariadb_session_pool;
 	std::mutex mariadb_session_pool_mutex;
+
+	std::unique_ptr<mariadb_session_struct> createSession();  // Called without pool lock held
+	std::unique_ptr<mariadb_session_struct> connectSession(const std::chrono::steady_clock::time_point &start);
+	void releaseSlot();  // Session closed / failed to connect, requires pool lock
 };
@@ -13,6 +13,7 @@
 
 #include "exceptions.h"
 #include "../md5/md5.h"
+#include "../metrics.h"
 
 
 MariaDBQuery::MariaDBQuery()
@@ -38,7 +39,11 @@ void MariaDBQuery::get(std::vector<sql_option> &output_options, std::string &str
 {
 	result_vec.clear();
 	do {
-		MYSQL_RES *result = (mysql_store_result(connector_ptr->mysql_ptr));  // Returns NULL for Errors & No Result
+		MYSQL_RES *result;
+		{
+			MetricsBlockedScope blocked;
+			result = (mysql_store_result(connector_ptr->mysql_ptr));  // Returns NULL for Errors & No Result
+		}
 		insertID = std::to_string(mysql_insert_id(connector_ptr->mysql_ptr));
 		if (!result)
 		{
@@ -55,187 +60,293 @@ void MariaDBQuery::get(std::vector<sql_option> &output_options, std::string &str
 				MYSQL_ROW row;
 				MYSQL_FIELD *fields;
 				fields = mysql_fetch_fields(result);
-				output_options.resize(num_fields);
 
 				while ((row = mysql_fetch_row(result)) != NULL)
 				{
 					std::vector<std::string> field_row;
-					for (unsigned int i = 0; i < num_fields; i++)
+					formatRow(row, fields, num_fields, output_options, strip_chars, strip_chars_mode, field_row);
+					result_vec.push_back(std::move(field_row));
+				}
+			}
+			mysql_free_result(result);
+		}
+	} while ((mysql_next_result(connector_ptr->mysql_ptr)) == 0);
+}
+
+
+void MariaDBQuery::formatRow(MYSQL_ROW &row, MYSQL_FIELD *fields, const unsigned int &num_fields, std::vector<sql_option> &output_options, std::string &strip_chars, int &strip_chars_mode, std::vector<std::string> &field_row)
+// OUTPUT Options are shared by every Worker Thread, so never resized here. Columns without one use defaults
+{
+	static const sql_option default_output_option;
+	for (unsigned int i = 0; i < num_fields; i++)
+	{
+		const sql_option &output_option = (i < output_options.size()) ? output_options[i] : default_output_option;
+		if (!(row[i]))
+		{
+			if (output_option.nullConvert)
+			{
+				field_row.emplace_back("objNull");
+			} else {
+				field_row.emplace_back("\"\"");
+			}
+			continue;
+		}
+		switch (fields[i].type)
+		{
+			case MYSQL_TYPE_DATE:
+			{
+				try
+				{
+					std::istringstream is(row[i]);
+					is.imbue(loc_date);
+					boost::posix_time::ptime ptime;
+					is >> ptime;
+
+					std::stringstream stream;
+					facet = new boost::posix_time::time_facet();
+					facet->format("[%Y,%m,%d]");
+					stream.imbue(std::locale(std::locale::classic(), facet));
+					stream << ptime;
+					std::string tmp_str = stream.str();
+					if (tmp_str != "not-a-date-time")
 					{
-						switch (fields[i].type)
-						{
-							case MYSQL_TYPE_DATE:
-							{
-								try
-								{
-									std::istringstream is(row[i]);
-									is.imbue(loc_date);
-									boost::posix_time::ptime ptime;
-									is >> ptime;
-
-									std::stringstream stream;
-									facet = new boost::posix_time::time_facet();
-									facet->format("[%Y,%m,%d]");
-									stream.imbue(std::locale(std::locale::classic(), facet));
-									stream << ptime;
-									std::string tmp_str = stream.str();
-									if (tmp_str != "not-a-date-time")
-									{
-										field_row.push_back(std::move(tmp_str));
-									} else {
-										field_row.emplace_back("[]");
-									}
-								}
-								catch(std::exception& e)
-								{
-									field_row.emplace_back("[]");
-								}
-								break;
-							}
-							case MYSQL_TYPE_DATETIME:
-							{
-								try
-								{
-									std::istringstream is(row[i]);
-									is.imbue(loc_datetime);
-									boost::posix_time::ptime ptime;
-									is >> ptime;
-
-									std::stringstream stream;
-									facet = new boost::posix_time::time_facet();
-									facet->format("[%Y,%m,%d,%H,%M,%S]");
-									stream.imbue(std::locale(std::locale::classic(), facet));
-									stream << ptime;
-									std::string tmp_str = stream.str();
-									if (tmp_str != "not-a-date-time")
-									{
-										field_row.push_back(std::move(tmp_str));
-									} else {
-										field_row.emplace_back("[]");
-									}
-								}
-								catch(std::exception& e)
-								{
-									field_row.emplace_back("[]");
-								}
-								break;
-							}
-							case MYSQL_TYPE_TIME:
-							{
-								try
-								{
-									std::istringstream is(row[i]);
-									is.imbue(loc_time);
-									boost::posix_time::ptime ptime;
-									is >> ptime;
-
-									std::stringstream stream;
-									facet = new boost::posix_time::time_facet();
-									facet->format("[%H,%M,%S]");
-									stream.imbue(std::locale(std::locale::classic(), facet));
-									stream << ptime;
-									std::string tmp_str = stream.str();
-									if (tmp_str != "not-a-date-time")
-									{
-										field_row.push_back(std::move(tmp_str));
-									} else {
-										field_row.emplace_back("[]");
-									}
-								}
-								catch(std::exception& e)
-								{
-									field_row.emplace_back("[]");
-								}
-								break;
-							}
-							case MYSQL_TYPE_NULL:
-							{
-								if (output_options[i].nullConvert)
-								{
-									field_row.emplace_back("objNull");
-								} else {
-									field_row.emplace_back("\"\"");
-								}
-								break;
-							}
-							default:
-							{
-								std::string tmp_str(row[i]);
+						field_row.push_back(std::move(tmp_str));
+					} else {
+						field_row.emplace_back("[]");
+					}
+				}
+				catch(std::exception& e)
+				{
+					field_row.emplace_back("[]");
+				}
+				break;
+			}
+			case MYSQL_TYPE_DATETIME:
+			{
+				try
+				{
+					std::istringstream is(row[i]);
+					is.imbue(loc_datetime);
+					boost::posix_time::ptime ptime;
+					is >> ptime;
 
-								if (output_options[i].strip)
-								{
-									std::string stripped_str(tmp_str);
-									for (auto &strip_char : strip_chars)
-									{
-										boost::erase_all(stripped_str, std::string(1, strip_char));
-									}
-									if (stripped_str != tmp_str)
-									{
-										switch (strip_chars_mode)
-										{
-											case 2: // Log + Error
-												throw extDB3Exception("Bad Character detected from database query");
-											//case 1: // Log
-												//logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, processed_inputs[i].buffer);
-										}
-										tmp_str = std::move(stripped_str);
-									}
-								}
-								if (output_options[i].beguidConvert)
-								{
-									try
-									{
-										int64_t steamID = std::stoll(tmp_str, nullptr);
-										std::stringstream bestring;
-										int8_t i = 0, parts[8] = { 0 };
-										do parts[i++] = steamID & 0xFF;
-										while (steamID >>= 8);
-										bestring << "BE";
-										for (int i = 0; i < sizeof(parts); i++) {
-											bestring << char(parts[i]);
-										}
-										tmp_str = md5(bestring.str());
-									}
-									catch(std::exception const & e)
-									{
-										tmp_str = "ERROR";
-									}
-								}
-								if (output_options[i].boolConvert)
-								{
-									if (tmp_str == "1")
-									{
-										tmp_str = "true";
-									} else {
-										tmp_str = "false";
-									}
-								}
-								if (output_options[i].string_remove_escape_quotes)
-								{
-									boost::replace_all(tmp_str, "\"\"", "\"");
-								}
-								if (output_options[i].string_add_escape_quotes)
-								{
-									boost::replace_all(tmp_str, "\"", "\"\"");
-								}
-								if (output_options[i].stringify)
-								{
-									tmp_str = "\"" + tmp_str + "\"";
-								}
-								if (output_options[i].stringify2)
-								{
-									tmp_str = "'" + tmp_str + "'";
-								}
-								field_row.push_back(std::move(tmp_str));
-							}
+					std::stringstream stream;
+					facet = new boost::posix_time::time_facet();
+					facet->format("[%Y,%m,%d,%H,%M,%S]");
+					stream.imbue(std::locale(std::locale::classic(), facet));
+					stream << ptime;
+					std::string tmp_str = stream.str();
+					if (tmp_str != "not-a-date-time")
+					{
+						field_row.push_back(std::move(tmp_str));
+					} else {
+						field_row.emplace_back("[]");
+					}
+				}
+				catch(std::exception& e)
+				{
+					field_row.emplace_back("[]");
+				}
+				break;
+			}
+			case MYSQL_TYPE_TIME:
+			{
+				try
+				{
+					std::istringstream is(row[i]);
+					is.imbue(loc_time);
+					boost::posix_time::ptime ptime;
+					is >> ptime;
+
+					std::stringstream stream;
+					facet = new boost::posix_time::time_facet();
+					facet->format("[%H,%M,%S]");
+					stream.imbue(std::locale(std::locale::classic(), facet));
+					stream << ptime;
+					std::string tmp_str = stream.str();
+					if (tmp_str != "not-a-date-time")
+					{
+						field_row.push_back(std::move(tmp_str));
+					} else {
+						field_row.emplace_back("[]");
+					}
+				}
+				catch(std::exception& e)
+				{
+					field_row.emplace_back("[]");
+				}
+				break;
+			}
+			case MYSQL_TYPE_NULL:
+			{
+				if (output_option.nullConvert)
+				{
+					field_row.emplace_back("objNull");
+				} else {
+					field_row.emplace_back("\"\"");
+				}
+				break;
+			}
+			default:
+			{
+				std::string tmp_str(row[i]);
+
+				if (output_option.strip)
+				{
+					std::string stripped_str(tmp_str);
+					for (auto &strip_char : strip_chars)
+					{
+						boost::erase_all(stripped_str, std::string(1, strip_char));
+					}
+					if (stripped_str != tmp_str)
+					{
+						switch (strip_chars_mode)
+						{
+							case 2: // Log + Error
+								throw extDB3Exception("Bad Character detected from database query");
+							//case 1: // Log
+								//logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, processed_inputs[i].buffer);
 						}
+						tmp_str = std::move(stripped_str);
 					}
-					result_vec.push_back(std::move(field_row));
 				}
+				if (output_option.beguidConvert)
+				{
+					try
+					{
+						int64_t steamID = std::stoll(tmp_str, nullptr);
+						std::stringstream bestring;
+						int8_t i = 0, parts[8] = { 0 };
+						do parts[i++] = steamID & 0xFF;
+						while (steamID >>= 8);
+						bestring << "BE";
+						for (int i = 0; i < sizeof(parts); i++) {
+							bestring << char(parts[i]);
+						}
+						tmp_str = md5(bestring.str());
+					}
+					catch(std::exception const & e)
+					{
+						tmp_str = "ERROR";
+					}
+				}
+				if (output_option.boolConvert)
+				{
+					if (tmp_str == "1")
+					{
+						tmp_str = "true";
+					} else {
+						tmp_str = "false";
+					}
+				}
+				if (output_option.string_remove_escape_quotes)
+				{
+					boost::replace_all(tmp_str, "\"\"", "\"");
+				}
+				if (output_option.string_add_escape_quotes)
+				{
+					boost::replace_all(tmp_str, "\"", "\"\"");
+				}
+				if (output_option.stringify)
+				{
+					tmp_str = "\"" + tmp_str + "\"";
+				}
+				if (output_option.stringify2)
+				{
+					tmp_str = "'" + tmp_str + "'";
+				}
+				field_row.push_back(std::move(tmp_str));
 			}
+		}
+	}
+}
+
+
+void MariaDBQuery::use(std::vector<sql_option> &output_options, std::string &insertID)
+// Unbuffered, rows stay on the Server until fetch() reads them. Connection can't be used for anything else until fetch() returns false / freeResult()
+{
+	stream_output_options = &output_options;
+	openResult(insertID);
+}
+
+
+void MariaDBQuery::openResult(std::string &insertID)
+// Next Result Set with columns, skips results without any i.e INSERT / UPDATE
+{
+	while (true)
+	{
+		{
+			MetricsBlockedScope blocked;
+			stream_result = mysql_use_result(connector_ptr->mysql_ptr);  // Returns NULL for Errors & No Result
+		}
+		insertID = std::to_string(mysql_insert_id(connector_ptr->mysql_ptr));
+		if (stream_result)
+		{
+			stream_num_fields = mysql_num_fields(stream_result);
+			stream_fields = mysql_fetch_fields(stream_result);
+			return;
+		}
+		if (mysql_errno(connector_ptr->mysql_ptr) != 0)
+		{
+			throw MariaDBQueryException(connector_ptr->mysql_ptr);
+		}
+		if (mysql_next_result(connector_ptr->mysql_ptr) != 0)
+		{
+			return;
+		}
+	}
+}
+
+
+bool MariaDBQuery::fetch(std::string &strip_chars, int &strip_chars_mode, std::vector<std::string> &field_row)
+// Next row of last use(), false once no rows are left in any Result Set
+{
+	while (stream_result)
+	{
+		MYSQL_ROW row;
+		{
+			MetricsBlockedScope blocked;
+			row = mysql_fetch_row(stream_result);
+		}
+		if (row)
+		{
+			field_row.clear();
+			formatRow(row, stream_fields, stream_num_fields, *stream_output_options, strip_chars, strip_chars_mode, field_row);
+			return true;
+		}
+		if (mysql_errno(connector_ptr->mysql_ptr) != 0)
+		{
+			throw MariaDBQueryException(connector_ptr->mysql_ptr);
+		}
+		mysql_free_result(stream_result);
+		stream_result = NULL;
+		if (mysql_next_result(connector_ptr->mysql_ptr) == 0)
+		{
+			std::string insertID;
+			openResult(insertID);
+		}
+	}
+	return false;
+}
+
+
+void MariaDBQuery::freeResult()
+// Discards rows + Result Sets not fetched yet
+{
+	MetricsBlockedScope blocked;
+	if (stream_result)
+	{
+		mysql_free_result(stream_result);
+		stream_result = NULL;
+	}
+	while (mysql_next_result(connector_ptr->mysql_ptr) == 0)
+	{
+		MYSQL_RES *result = mysql_use_result(connector_ptr->mysql_ptr);
+		if (result)
+		{
 			mysql_free_result(result);
 		}
-	} while ((mysql_next_result(connector_ptr->mysql_ptr)) == 0);
+	}
 }
 
 
@@ -243,7 +354,11 @@ void MariaDBQuery::get(int &check_dataType_string, bool &check_dataType_null, st
 {
 	result_vec.clear();
 	do {
-		MYSQL_RES *result = (mysql_store_result(connector_ptr->mysql_ptr));  // Returns NULL for Errors & No Result
+		MYSQL_RES *result;
+		{
+			MetricsBlockedScope blocked;
+			result = (mysql_store_result(connector_ptr->mysql_ptr));  // Returns NULL for Errors & No Result
+		}
 		insertID = std::to_string(mysql_insert_id(connector_ptr->mysql_ptr));
 		if (!result)
 		{
@@ -433,6 +548,7 @@ void MariaDBQuery::get(int &check_dataType_string, bool &check_dataType_null, st
 
 void MariaDBQuery::send(std::string &sql_query)
 {
+	MetricsBlockedScope blocked;
 	unsigned long len = sql_query.length();
 	int return_code = mysql_real_query(connector_ptr->mysql_ptr, sql_query.c_str(), len);
 	if (return_code != 0)
@@ -26,10 +26,23 @@ public:
 	void get(int &check_dataType_string, bool &check_dataType_null, std::string &insertID, std::vector<std::vector<std::string>> &result_vec);
 	void get(std::vector<sql_option> &output_options, std::string &strip_chars, int &strip_chars_mode, std::string &insertID, std::vector<std::vector<std::string>> &result_vec);
 
+	// Row at a time, used by Streaming Results
+	void use(std::vector<sql_option> &output_options, std::string &insertID);
+	bool fetch(std::string &strip_chars, int &strip_chars_mode, std::vector<std::string> &field_row);
+	void freeResult();
+
 private:
 	MariaDBConnector *connector_ptr;
 	std::locale loc_date;
 	std::locale loc_datetime;
 	std::locale loc_time;
 	boost::posix_time::time_facet* facet;
+
+	MYSQL_RES *stream_result = NULL;
+	MYSQL_FIELD *stream_fields = NULL;
+	unsigned int stream_num_fields = 0;
+	std::vector<sql_option> *stream_output_options = NULL;
+
+	void openResult(std::string &insertID);
+	void formatRow(MYSQL_ROW &row, MYSQL_FIELD *fields, const unsigned int &num_fields, std::vector<sql_option> &output_options, std::string &strip_chars, int &strip_chars_mode, std::vector<std::string> &field_row);
 };
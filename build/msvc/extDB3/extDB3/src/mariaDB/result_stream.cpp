@@ -0,0 +1,137 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "result_stream.h"
+
+
+MariaDBResultStream::MariaDBResultStream(MariaDBSession &&stream_session, MariaDBStatement *statement, const std::string &stream_strip_chars, const int &stream_strip_chars_mode,
+	std::string &&header, std::string &&stream_footer, std::vector<std::vector<std::string>> &&stream_buffered_rows)
+{
+	session.reset(new MariaDBSession(std::move(stream_session)));
+	statement_ptr = statement;
+	strip_chars = stream_strip_chars;
+	strip_chars_mode = stream_strip_chars_mode;
+	buffer = std::move(header);
+	footer = std::move(stream_footer);
+	buffered_rows = std::move(stream_buffered_rows);
+}
+
+
+MariaDBResultStream::~MariaDBResultStream(void)
+{
+	close(false);
+}
+
+
+void MariaDBResultStream::close(const bool &reset)
+// Discards rows not read yet, so the Session is clean for its next user
+//   reset = Stream Error, Session is reset same as a failed SQL_CUSTOM call
+{
+	if (session)
+	{
+		if (statement_ptr)
+		{
+			statement_ptr->freeResult();
+		} else {
+			session->data->query.freeResult();
+		}
+		if (reset)
+		{
+			session->resetSession();
+		}
+		session.reset();
+	}
+}
+
+
+bool MariaDBResultStream::nextRow()
+{
+	if (buffered_index < buffered_rows.size())
+	{
+		row = std::move(buffered_rows[buffered_index]);
+		if (++buffered_index == buffered_rows.size())
+		{
+			std::vector<std::vector<std::string>>().swap(buffered_rows);
+			buffered_index = 0;
+		}
+		return true;
+	}
+	if (!session)
+	{
+		return false;
+	}
+	if (statement_ptr)
+	{
+		return statement_ptr->fetch(strip_chars, strip_chars_mode, row);
+	}
+	return session->data->query.fetch(strip_chars, strip_chars_mode, row);
+}
+
+
+bool MariaDBResultStream::next(std::string &part, const std::size_t &part_size)
+{
+	if (offset > 0)
+	{
+		buffer.erase(0, offset);
+		offset = 0;
+	}
+
+	// Serialize rows until a whole part is buffered
+	try
+	{
+		while ((session) && (buffer.size() < part_size))
+		{
+			if (!nextRow())
+			{
+				buffer += footer;
+				session.reset(); // Drained, Session goes back to the pool straight away
+				break;
+			}
+			if (!first_row)
+			{
+				buffer += ",";
+			}
+			first_row = false;
+			buffer += "[";
+			for (auto &field : row)
+			{
+				if (field.empty())
+				{
+					buffer += "\"\"";
+				} else {
+					buffer += field;
+				}
+				buffer += ",";
+			}
+			if (!row.empty())
+			{
+				buffer.pop_back();
+			}
+			buffer += "]";
+		}
+	}
+	catch (...)
+	{
+		close(true);
+		throw;
+	}
+
+	std::size_t size = buffer.size();
+	if (size > part_size)
+	{
+		size = part_size;
+		while ((size > 0) && ((static_cast<unsigned char>(buffer[size]) & 0xC0) == 0x80))
+		{
+			--size; // Don't split UTF-8 Continuation Bytes
+		}
+		if (size == 0)
+		{
+			size = part_size;
+		}
+	}
+	part.assign(buffer, 0, size);
+	offset = size;
+	return ((session) || (offset < buffer.size()));
+}
@@ -0,0 +1,48 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "session.h"
+#include "statement.h"
+#include "../results.h"
+
+
+class MariaDBResultStream: public ResultStream
+// SQL_CUSTOM Streaming Result, rows are pulled from the Server + serialized one 5: part ahead of SQF on the Lane
+//   Same format as a buffered result i.e [1,[[row],...]], only one part + one row are held in memory
+//   Holds its Database Session until every row is read or the Stream is evicted (Stream TTL)
+{
+public:
+	// statement = nullptr, rows come from session Query (mysql_use_result)
+	MariaDBResultStream(MariaDBSession &&session, MariaDBStatement *statement, const std::string &strip_chars, const int &strip_chars_mode,
+		std::string &&header, std::string &&footer, std::vector<std::vector<std::string>> &&buffered_rows);
+	~MariaDBResultStream();
+
+	bool next(std::string &part, const std::size_t &part_size);
+
+private:
+	std::unique_ptr<MariaDBSession> session;  // Returned to the pool as soon as the last row is read
+	MariaDBStatement *statement_ptr;
+
+	std::string strip_chars;
+	int strip_chars_mode;
+
+	std::vector<std::vector<std::string>> buffered_rows;  // Rows of earlier SQL Lines, sent first
+	std::size_t buffered_index = 0;
+
+	std::string footer;
+	std::string buffer;       // Serialized, not handed out yet from offset
+	std::size_t offset = 0;
+	std::vector<std::string> row;
+	bool first_row = true;
+
+	bool nextRow();
+	void close(const bool &reset);
+};
@@ -12,9 +12,18 @@ MariaDBSession::MariaDBSession(MariaDBPool *database_pool)
 	data = database_pool->get();
 }
 
+MariaDBSession::MariaDBSession(MariaDBSession &&session)
+{
+	database_pool_ptr = session.database_pool_ptr;
+	data = std::move(session.data);
+}
+
 MariaDBSession::~MariaDBSession(void)
 {
-	database_pool_ptr->putBack(std::move(data));
+	if (data)
+	{
+		database_pool_ptr->putBack(std::move(data));
+	}
 }
 
 void MariaDBSession::resetSession()
@@ -12,6 +12,7 @@ class MariaDBSession
 {
 public:
 	MariaDBSession(MariaDBPool *database_pool);
+	MariaDBSession(MariaDBSession &&session);  // Hands Session over i.e to a Result Stream, moved-from Session returns nothing to the pool
 	~MariaDBSession();
 
 	std::unique_ptr<MariaDBPool::mariadb_session_struct> data;
@@ -5,6 +5,8 @@
 
 #include "statement.h"
 
+#include <algorithm>
+#include <charconv>
 #include <string>
 #include <sstream>
 
@@ -13,6 +15,7 @@
 
 #include "exceptions.h"
 #include "../md5/md5.h"
+#include "../metrics.h"
 
 
 MariaDBStatement::MariaDBStatement()
@@ -22,20 +25,11 @@ MariaDBStatement::MariaDBStatement()
 
 MariaDBStatement::~MariaDBStatement(void)
 {
-	if (mysql_stmt_result_metadata_ptr)
-	{
-		mysql_free_result(mysql_stmt_result_metadata_ptr);
-		mysql_stmt_result_metadata_ptr = NULL;
-	}
 	if (mysql_stmt_ptr)
 	{
 		mysql_stmt_close(mysql_stmt_ptr);
 	}
 	bind_data.clear();
-	if (mysql_bind_params)
-	{
-		delete[] mysql_bind_params;
-	}
 }
 
 
@@ -59,6 +53,7 @@ void MariaDBStatement::prepare(std::string &sql_query)
 {
 	if (!prepared)
 	{
+		MetricsBlockedScope blocked;
 		unsigned long len = sql_query.length();
 		int return_code = mysql_stmt_prepare(mysql_stmt_ptr, sql_query.c_str(), len);
 		if (return_code != 0)
@@ -70,6 +65,7 @@ void MariaDBStatement::prepare(std::string &sql_query)
 			}
 			if (return_code != 0) throw MariaDBStatementException0(connector_ptr->mysql_ptr);
 		}
+		bindResult();
 		prepared = true;
 	}
 }
@@ -82,21 +78,24 @@ unsigned long MariaDBStatement::getParamsCount()
 
 
 void MariaDBStatement::bindParams(std::vector<MariaDBStatement::mysql_bind_param> &params)
+// MYSQL_BIND array is reused + points straight at params, so params (+ the Tokens their values view) must outlive execute()
 {
-	int params_count = mysql_stmt_param_count(mysql_stmt_ptr); // mysql_stmt_ptr->param_count;
+	unsigned long params_count = mysql_stmt_param_count(mysql_stmt_ptr); // mysql_stmt_ptr->param_count;
 
 	if (params.size() != params_count)
 	{
 		throw extDB3Exception("SQL Invalid Number of Inputs Got " + std::to_string(params.size()) + " Expected " + std::to_string(params_count));
 	}
 
-	delete[] mysql_bind_params;
-	mysql_bind_params = new MYSQL_BIND[params_count];
-	//memset(&mysql_bind_params, 0, sizeof(&mysql_bind_params));
+	if (mysql_bind_params.size() != params_count)
+	{
+		mysql_bind_params.resize(params_count);
+	}
 
-	for (int i=0 ; i<params_count ; i++)
+	for (unsigned long i = 0; i < params_count; i++)
 	{
-		MYSQL_BIND mysql_bind = {0};
+		MYSQL_BIND &mysql_bind = mysql_bind_params[i];
+		mysql_bind = MYSQL_BIND();
 		MariaDBStatement::mysql_bind_param &param = params[i];
 
 		switch (param.type)
@@ -105,73 +104,40 @@ void MariaDBStatement::bindParams(std::vector<MariaDBStatement::mysql_bind_param
 			case MYSQL_TYPE_TIME:
 			case MYSQL_TYPE_DATETIME:
 			{
-				/*
-				unsigned int year	The year
-				unsigned int month	The month of the year
-				unsigned int day	The day of the month
-				unsigned int hour	The hour of the day
-				unsigned int minute	The minute of the hour
-				unsigned int second	The second of the minute
-				my_bool neg	A boolean flag indicating whether the time is negative
-				unsigned long second_part	The fractional part of the second in microseconds
-				*/
-				if (param.buffer.size() > 2)
-				{
-					param.buffer.erase(0,1);
-					param.buffer.pop_back();
-
-					std::vector<std::string> tokens;
-					boost::split(tokens, param.buffer, boost::is_any_of(","));
-					unsigned int time_value;
-					for (unsigned int i = 0; i < tokens.size(); i++)
-					{
-						try
-						{
-							time_value = std::stoul(tokens[i]);
-							switch (i)
-							{
-								case 0:
-									param.time_buffer.year = time_value;
-									break;
-								case 1:
-									param.time_buffer.month = time_value;
-									break;
-								case 2:
-									param.time_buffer.day = time_value;
-									break;
-								case 3:
-									param.time_buffer.hour = time_value;
-									break;
-								case 4:
-									param.time_buffer.minute = time_value;
-									break;
-								case 5:
-									param.time_buffer.second = time_value;
-									break;
-								default:
-									throw extDB3Exception("Invalid Time Format1: [" + param.buffer + "]");
-								}
-						}
-						catch(std::exception const &e)
-						{
-							throw extDB3Exception("Invalid Time Format2: [" + param.buffer + "]");
-						}
-					}
-				} else {
-					throw extDB3Exception("Invalid Time Format3: " + param.buffer);
-				}
+				parseTime(param);
 				mysql_bind.buffer_type = param.type;
 				mysql_bind.buffer = (char *)&(param.time_buffer);
 				break;
 			}
 
 			case MYSQL_TYPE_TINY:
+			{
+				mysql_bind.buffer_type = param.type;
+				mysql_bind.buffer = &param.buffer_tiny;
+				break;
+			}
+			case MYSQL_TYPE_LONG:
+			{
+				mysql_bind.buffer_type = param.type;
+				mysql_bind.buffer = &param.buffer_long;
+				break;
+			}
+			case MYSQL_TYPE_LONGLONG:
+			{
+				mysql_bind.buffer_type = param.type;
+				mysql_bind.buffer = &param.buffer_longlong;
+				break;
+			}
+			case MYSQL_TYPE_DOUBLE:
+			{
+				mysql_bind.buffer_type = param.type;
+				mysql_bind.buffer = &param.buffer_double;
+				break;
+			}
+
 			case MYSQL_TYPE_SHORT:
 			case MYSQL_TYPE_INT24:
-			case MYSQL_TYPE_LONG:
 			case MYSQL_TYPE_FLOAT:
-			case MYSQL_TYPE_DOUBLE:
-			case MYSQL_TYPE_LONGLONG:
 			case MYSQL_TYPE_DECIMAL:
 			case MYSQL_TYPE_NEWDECIMAL:
 			case MYSQL_TYPE_STRING:
@@ -180,12 +146,11 @@ void MariaDBStatement::bindParams(std::vector<MariaDBStatement::mysql_bind_param
 			case MYSQL_TYPE_TINY_BLOB:
 			case MYSQL_TYPE_MEDIUM_BLOB:
 			case MYSQL_TYPE_BLOB:
+			case MYSQL_TYPE_LONG_BLOB:
 			{
 				mysql_bind.buffer_type = MYSQL_TYPE_STRING;
-				param.buffer_c.reset(new char[param.length+1]);
-				std::copy(param.buffer.begin(), param.buffer.end(), param.buffer_c.get());
-				mysql_bind.buffer  = param.buffer_c.get();
-				mysql_bind.buffer_length = param.length;
+				mysql_bind.buffer  = const_cast<char *>(param.value.data()); // Input only, never written by libmariadb
+				mysql_bind.buffer_length = param.value.size();
 				break;
 			}
 			case MYSQL_TYPE_NULL:
@@ -194,16 +159,60 @@ void MariaDBStatement::bindParams(std::vector<MariaDBStatement::mysql_bind_param
 				mysql_bind.buffer_length = 0;
 				break;
 			}
-			case MYSQL_TYPE_LONG_BLOB:
-			{
-				throw extDB3Exception("Field Type not supported: LONGBLOB/LONGTEXT");
-			}
 			default:
 				throw extDB3Exception("Unknown Field Type: " + std::to_string(param.type));
 		}
-		mysql_bind_params[i] = (std::move(mysql_bind));
 	}
-	mysql_stmt_bind_param(mysql_stmt_ptr, mysql_bind_params);
+	mysql_stmt_bind_param(mysql_stmt_ptr, mysql_bind_params.data());
+}
+
+
+void MariaDBStatement::parseTime(MariaDBStatement::mysql_bind_param &param)
+// [Year,Month,Day,Hour,Minute,Second] -> MYSQL_TIME, parsed in place
+{
+	/*
+	unsigned int year	The year
+	unsigned int month	The month of the year
+	unsigned int day	The day of the month
+	unsigned int hour	The hour of the day
+	unsigned int minute	The minute of the hour
+	unsigned int second	The second of the minute
+	my_bool neg	A boolean flag indicating whether the time is negative
+	unsigned long second_part	The fractional part of the second in microseconds
+	*/
+	if (param.value.size() <= 2)
+	{
+		throw extDB3Exception("Invalid Time Format3: " + std::string(param.value));
+	}
+
+	param.time_buffer = MYSQL_TIME();
+	unsigned int *time_values[6] = {&param.time_buffer.year, &param.time_buffer.month, &param.time_buffer.day,
+		&param.time_buffer.hour, &param.time_buffer.minute, &param.time_buffer.second};
+
+	const char *pos = param.value.data() + 1;
+	const char *end = param.value.data() + param.value.size() - 1;
+	for (unsigned int i = 0; ; i++)
+	{
+		if (i >= 6)
+		{
+			throw extDB3Exception("Invalid Time Format1: " + std::string(param.value));
+		}
+		while ((pos < end) && (*pos == ' '))
+		{
+			++pos;
+		}
+		const std::from_chars_result parsed = std::from_chars(pos, end, *time_values[i]);
+		if ((parsed.ec != std::errc()) || (parsed.ptr == pos))
+		{
+			throw extDB3Exception("Invalid Time Format2: " + std::string(param.value));
+		}
+		pos = std::find(parsed.ptr, end, ',');
+		if (pos == end)
+		{
+			break;
+		}
+		++pos;
+	}
 }
 
 
@@ -213,298 +222,408 @@ bool MariaDBStatement::errorCheck()
 }
 
 
-void MariaDBStatement::execute(std::vector<sql_option> &output_options, std::string &strip_chars, int &strip_chars_mode, std::string &insertID, std::vector<std::vector<std::string>> &results)
+void MariaDBStatement::bindResult()
+// Result Binding Plan, Metadata / MYSQL_BIND array / Buffers are set up once + reused by every execute()
 {
-	mysql_stmt_result_metadata_ptr = mysql_stmt_result_metadata(mysql_stmt_ptr);
-	if (mysql_stmt_result_metadata_ptr)
+	num_fields = mysql_stmt_field_count(mysql_stmt_ptr);
+	mysql_bind_result.assign(num_fields, MYSQL_BIND());
+	bind_data.clear();
+	bind_data.resize(num_fields);
+	if (num_fields == 0)
 	{
-		num_fields = mysql_num_fields(mysql_stmt_result_metadata_ptr);
-		fields = mysql_fetch_fields(mysql_stmt_result_metadata_ptr);
+		return;
+	}
 
-		mysql_bind_result = new MYSQL_BIND[num_fields];
-		memset(mysql_bind_result, 0, sizeof(MYSQL_BIND)*num_fields);
+	MYSQL_RES *mysql_stmt_result_metadata_ptr = mysql_stmt_result_metadata(mysql_stmt_ptr);
+	if (!mysql_stmt_result_metadata_ptr)
+	{
+		throw MariaDBStatementException1(mysql_stmt_ptr);
+	}
+	MYSQL_FIELD *fields = mysql_fetch_fields(mysql_stmt_result_metadata_ptr);
 
-		bind_data.clear();
-		bind_data.resize(num_fields);
+	// Setup Buffers
+	// MYSQL Types http://dev.mysql.com/doc/refman/5.7/en/c-api-prepared-statement-type-codes.html
+	std::size_t size = 0;
+	for (unsigned int i = 0; i < num_fields; i++)
+	{
+		bind_data[i].type = fields[i].type;
+		switch (fields[i].type)
+		{
+		case MYSQL_TYPE_DATE:
+		case MYSQL_TYPE_TIME:
+		case MYSQL_TYPE_TIMESTAMP:
+		case MYSQL_TYPE_DATETIME:
+		{
+			mysql_bind_result[i].buffer_type = fields[i].type;
+			mysql_bind_result[i].buffer = &bind_data[i].buffer_mysql_time;
+			mysql_bind_result[i].buffer_length = sizeof(MYSQL_TIME);
+			break;
+		}
+		case MYSQL_TYPE_NEWDECIMAL:
+		case MYSQL_TYPE_DECIMAL:
+		case MYSQL_TYPE_STRING:
+		case MYSQL_TYPE_VAR_STRING:
+		case MYSQL_TYPE_TINY_BLOB:
+		case MYSQL_TYPE_MEDIUM_BLOB:
+		case MYSQL_TYPE_BLOB:
+		case MYSQL_TYPE_LONG_BLOB:
+		{
+			// Column Length is the max possible i.e 16MB for MEDIUMBLOB, longer values are read by fetchColumn instead
+			mysql_bind_result[i].buffer_type = MYSQL_TYPE_STRING;
+			size = std::min<std::size_t>(fields[i].length, result_buffer_size);
+			unsigned int len = static_cast<unsigned int>(size);
+
+			bind_data[i].buffer.resize(len + 1);
+			mysql_bind_result[i].buffer_length = len;
+			mysql_bind_result[i].buffer = (len > 0) ? &bind_data[i].buffer[0] : NULL;
+			break;
+		}
 
-		// Setup Buffers
-		// MYSQL Types http://dev.mysql.com/doc/refman/5.7/en/c-api-prepared-statement-type-codes.html
-		std::size_t size = 0;
-		for (unsigned int i = 0; i < num_fields; i++)
+		case MYSQL_TYPE_SHORT:
 		{
-			switch (fields[i].type)
-			{
-			case MYSQL_TYPE_DATE:
-			case MYSQL_TYPE_TIME:
-			case MYSQL_TYPE_TIMESTAMP:
-			case MYSQL_TYPE_DATETIME:
-			{
-				mysql_bind_result[i].buffer_type = fields[i].type;
-				mysql_bind_result[i].buffer = &bind_data[i].buffer_mysql_time;
-				mysql_bind_result[i].buffer_length = sizeof(MYSQL_TIME);
-				break;
-			}
-			case MYSQL_TYPE_LONG_BLOB:
-			{
-				throw extDB3Exception("MYSQL_TYPE_LONG_BLOB type not supported when using Prepared Statements");
-			}
+			mysql_bind_result[i].buffer_length = sizeof(short);
+			mysql_bind_result[i].buffer_type = fields[i].type;
+			mysql_bind_result[i].buffer = &bind_data[i].buffer_short;
+			break;
+		}
+
+		case MYSQL_TYPE_DOUBLE:
+		{
+			mysql_bind_result[i].buffer_length = sizeof(double);
+			mysql_bind_result[i].buffer_type = fields[i].type;
+			mysql_bind_result[i].buffer = &bind_data[i].buffer_double;
+			break;
+		}
+		case MYSQL_TYPE_FLOAT:
+		{
+			mysql_bind_result[i].buffer_length = sizeof(float);
+			mysql_bind_result[i].buffer_type = fields[i].type;
+			mysql_bind_result[i].buffer = &bind_data[i].buffer_float;
+			break;
+		}
+
+		case MYSQL_TYPE_INT24:
+		case MYSQL_TYPE_LONG:
+		{
+			mysql_bind_result[i].buffer_length = sizeof(long);
+			mysql_bind_result[i].buffer_type = fields[i].type;
+			mysql_bind_result[i].buffer = &bind_data[i].buffer_long;
+			break;
+		}
+		case MYSQL_TYPE_LONGLONG:
+		{
+			mysql_bind_result[i].buffer_length = sizeof(long long int);
+			mysql_bind_result[i].buffer_type = fields[i].type;
+			mysql_bind_result[i].buffer = &bind_data[i].buffer_longlong;
+			break;
+		}
+		/*
+			case MYSQL_TYPE_TINY:
+			case MYSQL_TYPE_BIT:
 			case MYSQL_TYPE_NEWDECIMAL:
-			case MYSQL_TYPE_DECIMAL:
-			case MYSQL_TYPE_STRING:
-			case MYSQL_TYPE_VAR_STRING:
-			case MYSQL_TYPE_TINY_BLOB:
-			case MYSQL_TYPE_MEDIUM_BLOB:
-			case MYSQL_TYPE_BLOB:
-			{
-				mysql_bind_result[i].buffer_type = MYSQL_TYPE_STRING;
-				size = fields[i].length;
-				if (size == 0xFFFFFFFF) size = 0;
-				unsigned int len = static_cast<unsigned int>(size);
-
-				bind_data[i].buffer.resize(len + 1);
-				mysql_bind_result[i].buffer_length = len;
-				mysql_bind_result[i].buffer = (len > 0) ? &bind_data[i].buffer[0] : NULL;
-				break;
-			}
+		*/
+		default:
+		{
+			mysql_bind_result[i].buffer_type = MYSQL_TYPE_STRING;
 
-			case MYSQL_TYPE_SHORT:
-			{
-				mysql_bind_result[i].buffer_length = sizeof(short);
-				mysql_bind_result[i].buffer_type = fields[i].type;
-				mysql_bind_result[i].buffer = &bind_data[i].buffer_short;
-				break;
-			}
+			size = sizeof(fields[i].type);
+			if (size == 0xFFFFFFFF) size = 0;
+			unsigned int len = static_cast<unsigned int>(size);
 
-			case MYSQL_TYPE_DOUBLE:
-			{
-				mysql_bind_result[i].buffer_length = sizeof(double);
-				mysql_bind_result[i].buffer_type = fields[i].type;
-				mysql_bind_result[i].buffer = &bind_data[i].buffer_double;
-				break;
-			}
-			case MYSQL_TYPE_FLOAT:
-			{
-				mysql_bind_result[i].buffer_length = sizeof(float);
-				mysql_bind_result[i].buffer_type = fields[i].type;
-				mysql_bind_result[i].buffer = &bind_data[i].buffer_float;
-				break;
-			}
+			bind_data[i].buffer.resize(len + 1);
+			mysql_bind_result[i].buffer_length = len;
+			mysql_bind_result[i].buffer = (len > 0) ? &bind_data[i].buffer[0] : NULL;
+			break;
+		}
+		}
+		mysql_bind_result[i].length = &(bind_data[i].length);
+		mysql_bind_result[i].is_null = &(bind_data[i].isNull);
+		mysql_bind_result[i].is_unsigned = (fields[i].flags & UNSIGNED_FLAG) > 0;
+		mysql_bind_result[i].error = &(bind_data[i].error);
+	};
+	mysql_free_result(mysql_stmt_result_metadata_ptr);
 
-			case MYSQL_TYPE_INT24:
-			case MYSQL_TYPE_LONG:
-			{
-				mysql_bind_result[i].buffer_length = sizeof(long);
-				mysql_bind_result[i].buffer_type = fields[i].type;
-				mysql_bind_result[i].buffer = &bind_data[i].buffer_long;
-				break;
-			}
-			case MYSQL_TYPE_LONGLONG:
-			{
-				mysql_bind_result[i].buffer_length = sizeof(long long int);
-				mysql_bind_result[i].buffer_type = fields[i].type;
-				mysql_bind_result[i].buffer = &bind_data[i].buffer_longlong;
-				break;
-			}
-			/*
-				case MYSQL_TYPE_TINY:
-				case MYSQL_TYPE_BIT:
-				case MYSQL_TYPE_NEWDECIMAL:
-			*/
-			default:
-			{
-				mysql_bind_result[i].buffer_type = MYSQL_TYPE_STRING;
+	if (mysql_stmt_bind_result(mysql_stmt_ptr, mysql_bind_result.data()) != 0)
+	{
+		num_fields = 0;
+		throw MariaDBStatementException1(mysql_stmt_ptr);
+	}
+}
 
-				size = sizeof(fields[i].type);
-				if (size == 0xFFFFFFFF) size = 0;
-				unsigned int len = static_cast<unsigned int>(size);
 
-				bind_data[i].buffer.resize(len + 1);
-				mysql_bind_result[i].buffer_length = len;
-				mysql_bind_result[i].buffer = (len > 0) ? &bind_data[i].buffer[0] : NULL;
-				break;
-			}
-			}
-			mysql_bind_result[i].length = &(bind_data[i].length);
-			mysql_bind_result[i].is_null = &(bind_data[i].isNull);
-			mysql_bind_result[i].is_unsigned = (fields[i].flags & UNSIGNED_FLAG) > 0;
-			mysql_bind_result[i].error = &(bind_data[i].error);
-		};
-		if (mysql_stmt_bind_result(mysql_stmt_ptr, mysql_bind_result) != 0)
+bool MariaDBStatement::resultChanged()
+// Compares Result Metadata of last execute() against Binding Plan
+//   Column Count alone misses ALTER TABLE ... MODIFY i.e INT -> BIGINT, so Column Types are compared as well
+{
+	if (mysql_stmt_field_count(mysql_stmt_ptr) != num_fields)
+	{
+		return true;
+	}
+	if (num_fields == 0)
+	{
+		return false;
+	}
+	MYSQL_RES *mysql_stmt_result_metadata_ptr = mysql_stmt_result_metadata(mysql_stmt_ptr);
+	if (!mysql_stmt_result_metadata_ptr)
+	{
+		return true; // bindResult reports the error
+	}
+	MYSQL_FIELD *fields = mysql_fetch_fields(mysql_stmt_result_metadata_ptr);
+	bool changed = false;
+	for (unsigned int i = 0; i < num_fields; i++)
+	{
+		if ((fields[i].type != bind_data[i].type) || (((fields[i].flags & UNSIGNED_FLAG) > 0) != (mysql_bind_result[i].is_unsigned != 0)))
 		{
-			throw MariaDBStatementException1(mysql_stmt_ptr);
+			changed = true;
+			break;
 		}
-	};
-	
+	}
+	mysql_free_result(mysql_stmt_result_metadata_ptr);
+	return changed;
+}
 
-	if (mysql_stmt_execute(mysql_stmt_ptr) != 0)
+
+void MariaDBStatement::fetchColumn(const unsigned int &column, std::string &value)
+// Value was truncated to its Result Buffer, read the whole Column again straight into value
+{
+	value.resize(bind_data[column].length);
+	unsigned long length = 0;
+	MYSQL_BIND mysql_bind = MYSQL_BIND();
+	mysql_bind.buffer_type = MYSQL_TYPE_STRING;
+	mysql_bind.buffer = &value[0];
+	mysql_bind.buffer_length = bind_data[column].length;
+	mysql_bind.length = &length;
+	if (mysql_stmt_fetch_column(mysql_stmt_ptr, &mysql_bind, column, 0) != 0)
 	{
 		throw MariaDBStatementException1(mysql_stmt_ptr);
 	}
-	if (mysql_stmt_store_result(mysql_stmt_ptr))
+	value.resize(std::min(length, bind_data[column].length));
+}
+
+
+void MariaDBStatement::execute(std::vector<sql_option> &output_options, std::string &strip_chars, int &strip_chars_mode, std::string &insertID, std::vector<std::vector<std::string>> &results)
+{
+	execute(output_options, insertID, true);
+	std::vector<std::string> row;
+	while (fetch(strip_chars, strip_chars_mode, row))
 	{
-		throw MariaDBStatementException1(mysql_stmt_ptr);
+		results.push_back(std::move(row));
+	}
+}
+
+
+void MariaDBStatement::execute(std::vector<sql_option> &output_options, std::string &insertID, const bool &buffered)
+// buffered = false, rows are left on the Server + read by fetch() as they are needed. Connection can't be used for anything else until fetch() returns false / freeResult()
+{
+	{
+		MetricsBlockedScope blocked;
+		if (mysql_stmt_execute(mysql_stmt_ptr) != 0)
+		{
+			throw MariaDBStatementException1(mysql_stmt_ptr);
+		}
+		if (resultChanged())
+		{
+			// Server sent different Result Metadata i.e Table altered + Statement re-prepared
+			bindResult();
+		}
+		if ((buffered) && (mysql_stmt_store_result(mysql_stmt_ptr)))
+		{
+			throw MariaDBStatementException1(mysql_stmt_ptr);
+		}
 	}
 
 	insertID = std::to_string(mysql_stmt_insert_id(mysql_stmt_ptr));
 
-	if (mysql_stmt_result_metadata_ptr)
+	// OUTPUT Options are shared by every Worker Thread, so never resized here. Columns without one use defaults
+	static const sql_option default_output_option;
+	output_plan.resize(num_fields);
+	for (unsigned int i = 0; i < num_fields; i++)
+	{
+		output_plan[i] = (i < output_options.size()) ? &output_options[i] : &default_output_option;
+	}
+}
+
+
+bool MariaDBStatement::fetch(std::string &strip_chars, int &strip_chars_mode, std::vector<std::string> &row)
+// Next row of last execute(), false once no rows are left
+{
+	if (num_fields == 0)
+	{
+		return false;
+	}
+	int error_code;
+	{
+		MetricsBlockedScope blocked;
+		error_code = mysql_stmt_fetch(mysql_stmt_ptr);
+	}
+	if ((error_code !=0) && (error_code != MYSQL_NO_DATA) && (error_code != MYSQL_DATA_TRUNCATED))
 	{
-		int error_code = 0;
-		while (true)
+		throw MariaDBStatementException1(mysql_stmt_ptr);
+	}
+	if (error_code == MYSQL_NO_DATA)
+	{
+		return false;
+	}
+	if (error_code == MYSQL_DATA_TRUNCATED)
+	{
+		// Only String Buffers are read again via fetchColumn, any other truncated Column can't be recovered
+		for (unsigned int i = 0; i < num_fields; i++)
 		{
-			error_code = mysql_stmt_fetch(mysql_stmt_ptr);
-			if ((error_code !=0) && (error_code != MYSQL_NO_DATA))
+			if ((bind_data[i].error) && (mysql_bind_result[i].buffer_type != MYSQL_TYPE_STRING))
 			{
 				throw MariaDBStatementException1(mysql_stmt_ptr);
 			}
-			if (error_code != 0) break;
+		}
+	}
 
-			//Process Result
-			std::vector<std::string> result;
-			output_options.resize(num_fields);
-			for (unsigned int i = 0; i < num_fields; i++)
+	//Process Result
+	row.clear();
+	row.reserve(num_fields);
+	for (unsigned int i = 0; i < num_fields; i++)
+	{
+		const sql_option &output_option = *output_plan[i];
+		if (bind_data[i].isNull)
+		{
+			if (output_option.nullConvert)
+			{
+				row.emplace_back("objNull");
+			} else {
+				row.emplace_back("\"\"");
+			}
+		} else {
+			switch (bind_data[i].type)
 			{
-				if (bind_data[i].isNull)
+				case MYSQL_TYPE_DATE:
+				case MYSQL_TYPE_TIME:
+				case MYSQL_TYPE_DATETIME:
+				case MYSQL_TYPE_TIMESTAMP:
 				{
-					if (output_options[i].nullConvert)
+					row.emplace_back("[" +
+																std::to_string(bind_data[i].buffer_mysql_time.year) + "," +
+																std::to_string(bind_data[i].buffer_mysql_time.month) + "," +
+																std::to_string(bind_data[i].buffer_mysql_time.day) + "," +
+																std::to_string(bind_data[i].buffer_mysql_time.hour) + "," +
+																std::to_string(bind_data[i].buffer_mysql_time.minute) + "," +
+																std::to_string(bind_data[i].buffer_mysql_time.second) +
+															"]");
+					break;
+				}
+				case MYSQL_TYPE_NULL:
+				{
+					if (output_option.nullConvert)
 					{
-						result.emplace_back("objNull");
+						row.emplace_back("objNull");
 					} else {
-						result.emplace_back("\"\"");
+						row.emplace_back("\"\"");
 					}
-				} else {
-					switch (fields[i].type)
+					break;
+				}
+				default:
+					std::string tmp_str;
+
+					switch (bind_data[i].type)
 					{
-						case MYSQL_TYPE_DATE:
-						case MYSQL_TYPE_TIME:
-						case MYSQL_TYPE_DATETIME:
-						case MYSQL_TYPE_TIMESTAMP:
-						{
-							result.emplace_back("[" +
-																		std::to_string(bind_data[i].buffer_mysql_time.year) + "," +
-																		std::to_string(bind_data[i].buffer_mysql_time.month) + "," +
-																		std::to_string(bind_data[i].buffer_mysql_time.day) + "," +
-																		std::to_string(bind_data[i].buffer_mysql_time.hour) + "," +
-																		std::to_string(bind_data[i].buffer_mysql_time.minute) + "," +
-																		std::to_string(bind_data[i].buffer_mysql_time.second) +
-																	"]");
+						case MYSQL_TYPE_SHORT:
+							tmp_str = std::to_string(bind_data[i].buffer_short);
 							break;
-						}
-						case MYSQL_TYPE_NULL:
-						{
-							if (output_options[i].nullConvert)
+						case MYSQL_TYPE_DOUBLE:
+							tmp_str = std::to_string(bind_data[i].buffer_double);
+							break;
+						case MYSQL_TYPE_FLOAT:
+							tmp_str = std::to_string(bind_data[i].buffer_float);
+							break;
+						case MYSQL_TYPE_INT24:
+						case MYSQL_TYPE_LONG:
+							tmp_str = std::to_string(bind_data[i].buffer_long);
+							break;
+						case MYSQL_TYPE_LONGLONG:
+							tmp_str = std::to_string(bind_data[i].buffer_longlong);
+							break;
+						default:
+							if (bind_data[i].length > mysql_bind_result[i].buffer_length)
 							{
-								result.emplace_back("objNull");
+								fetchColumn(i, tmp_str);
 							} else {
-								result.emplace_back("\"\"");
+								tmp_str = std::string(&bind_data[i].buffer[0], bind_data[i].length);
 							}
-							break;
-						}
+					}
 
-						case MYSQL_TYPE_LONG_BLOB:
+					if (output_option.strip)
+					{
+						std::string stripped_str(tmp_str);
+						for (auto &strip_char : strip_chars)
 						{
-							throw extDB3Exception("MYSQL_TYPE_LONG_BLOB type not supported");
+							boost::erase_all(stripped_str, std::string(1, strip_char));
 						}
-						default:
-							std::string tmp_str;
-
-							switch (fields[i].type)
-							{
-								case MYSQL_TYPE_SHORT:
-									tmp_str = std::to_string(bind_data[i].buffer_short);
-									break;
-								case MYSQL_TYPE_DOUBLE:
-									tmp_str = std::to_string(bind_data[i].buffer_double);
-									break;
-								case MYSQL_TYPE_FLOAT:
-									tmp_str = std::to_string(bind_data[i].buffer_float);
-									break;
-								case MYSQL_TYPE_INT24:
-								case MYSQL_TYPE_LONG:
-									tmp_str = std::to_string(bind_data[i].buffer_long);
-									break;
-								case MYSQL_TYPE_LONGLONG:
-									tmp_str = std::to_string(bind_data[i].buffer_longlong);
-									break;
-								default:
-									tmp_str = std::string(&bind_data[i].buffer[0], bind_data[i].length);
-							}
-
-							if (output_options[i].strip)
-							{
-								std::string stripped_str(tmp_str);
-								for (auto &strip_char : strip_chars)
-								{
-									boost::erase_all(stripped_str, std::string(1, strip_char));
-								}
-								if (stripped_str != tmp_str)
-								{
-									switch (strip_chars_mode)
-									{
-									case 2: // Log + Error
-										throw extDB3Exception("Bad Character detected from database query");
-										//case 1: // Log
-										//logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, processed_inputs[i].buffer);
-									}
-									tmp_str = std::move(stripped_str);
-								}
-							}
-							if (output_options[i].beguidConvert)
-							{
-								try
-								{
-									int64_t steamID = std::stoll(tmp_str, nullptr);
-									std::stringstream bestring;
-									int8_t i = 0, parts[8] = { 0 };
-									do parts[i++] = steamID & 0xFF;
-									while (steamID >>= 8);
-									bestring << "BE";
-									for (int i = 0; i < sizeof(parts); i++) {
-										bestring << char(parts[i]);
-									}
-									tmp_str = md5(bestring.str());
-								}
-								catch (std::exception const & e)
-								{
-									tmp_str = "ERROR";
-								}
-							}
-							if (output_options[i].boolConvert)
-							{
-								if (tmp_str == "1")
-								{
-									tmp_str = "true";
-								}
-								else {
-									tmp_str = "false";
-								}
-							}
-							if (output_options[i].string_remove_escape_quotes)
-							{
-								boost::replace_all(tmp_str, "\"\"", "\"");
-							}
-							if (output_options[i].string_add_escape_quotes)
-							{
-								boost::replace_all(tmp_str, "\"", "\"\"");
-							}
-							if (output_options[i].stringify)
+						if (stripped_str != tmp_str)
+						{
+							switch (strip_chars_mode)
 							{
-								tmp_str = "\"" + tmp_str + "\"";
+							case 2: // Log + Error
+								throw extDB3Exception("Bad Character detected from database query");
+								//case 1: // Log
+								//logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, processed_inputs[i].buffer);
 							}
-							if (output_options[i].stringify2)
-							{
-								tmp_str = "'" + tmp_str + "'";
+							tmp_str = std::move(stripped_str);
+						}
+					}
+					if (output_option.beguidConvert)
+					{
+						try
+						{
+							int64_t steamID = std::stoll(tmp_str, nullptr);
+							std::stringstream bestring;
+							int8_t i = 0, parts[8] = { 0 };
+							do parts[i++] = steamID & 0xFF;
+							while (steamID >>= 8);
+							bestring << "BE";
+							for (int i = 0; i < sizeof(parts); i++) {
+								bestring << char(parts[i]);
 							}
-							result.push_back(std::move(tmp_str));
+							tmp_str = md5(bestring.str());
+						}
+						catch (std::exception const & e)
+						{
+							tmp_str = "ERROR";
+						}
 					}
-				}
+					if (output_option.boolConvert)
+					{
+						if (tmp_str == "1")
+						{
+							tmp_str = "true";
+						}
+						else {
+							tmp_str = "false";
+						}
+					}
+					if (output_option.string_remove_escape_quotes)
+					{
+						boost::replace_all(tmp_str, "\"\"", "\"");
+					}
+					if (output_option.string_add_escape_quotes)
+					{
+						boost::replace_all(tmp_str, "\"", "\"\"");
+					}
+					if (output_option.stringify)
+					{
+						tmp_str = "\"" + tmp_str + "\"";
+					}
+					if (output_option.stringify2)
+					{
+						tmp_str = "'" + tmp_str + "'";
+					}
+					row.push_back(std::move(tmp_str));
 			}
-			results.push_back(std::move(result));
 		}
 	}
+	return true;
+}
 
-	mysql_free_result(mysql_stmt_result_metadata_ptr);
-	mysql_stmt_result_metadata_ptr = NULL;
-	delete[] mysql_bind_result;
-	bind_data.clear();
+
+void MariaDBStatement::freeResult()
+// Discards rows not fetched yet
+{
+	MetricsBlockedScope blocked;
+	mysql_stmt_free_result(mysql_stmt_ptr);
 }
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include <mariadb/mysql.h>
@@ -24,11 +26,16 @@ public:
 	struct mysql_bind_param
 	{
 		enum_field_types type = MYSQL_TYPE_NULL;
-		std::string buffer;
-		std::unique_ptr<char[]> buffer_c;
-		std::size_t length = 0;
+		std::string_view value;  // Bound bytes, views caller's Input Token or buffer
+		std::string buffer;      // Only used once an INPUT Option rewrites value
 		bool is_unsigned = false;
 		MYSQL_TIME time_buffer;
+
+		// Native INPUT Types
+		signed char buffer_tiny = 0;
+		int buffer_long = 0;
+		long long buffer_longlong = 0;
+		double buffer_double = 0;
 	};
 
 	void init(MariaDBConnector &connector);
@@ -36,28 +43,41 @@ public:
 	void prepare(std::string & sql_query);
 	unsigned long getParamsCount();
 	void bindParams(std::vector<mysql_bind_param> &params);
+	std::vector<mysql_bind_param> params;  // Reused by caller between executes, keeps buffer capacity
 	void execute(std::vector<sql_option> &output_options, std::string &strip_chars, int &strip_chars_mode, std::string &insertID, std::vector<std::vector<std::string>> &result_vec);
+
+	// Row at a time, used by Streaming Results
+	void execute(std::vector<sql_option> &output_options, std::string &insertID, const bool &buffered);
+	bool fetch(std::string &strip_chars, int &strip_chars_mode, std::vector<std::string> &row);
+	void freeResult();
 	bool errorCheck();
 
 private:
 	bool prepared = false;
 	MariaDBConnector *connector_ptr;
 
-	MYSQL_RES *mysql_stmt_result_metadata_ptr = NULL;
 	MYSQL_STMT *mysql_stmt_ptr = NULL;
 
-	MYSQL_BIND *mysql_bind_params = NULL;
-	MYSQL_BIND *mysql_bind_result = NULL;
-	MYSQL_FIELD *fields = NULL;
+	std::vector<MYSQL_BIND> mysql_bind_params;  // Reused, points at caller's mysql_bind_param values
+	void parseTime(mysql_bind_param &param);
+
+	// Result Binding Plan, built at prepare + rebuilt only if the Server's Result Metadata no longer matches it
+	void bindResult();
+	bool resultChanged();
+	unsigned int num_fields = 0;
+	std::vector<MYSQL_BIND> mysql_bind_result;
+	std::vector<const sql_option *> output_plan;  // OUTPUT Option per Column
 
-	unsigned int num_fields;
+	// Initial Result Buffer per String / BLOB Column, values that don't fit are read by fetchColumn
+	static constexpr std::size_t result_buffer_size = 256;
+	void fetchColumn(const unsigned int &column, std::string &value);
 
 	struct mysql_bind_field
 	{
 		unsigned long      length;
 		my_bool            isNull;
 		my_bool            error;
-		//enum_field_types   type;
+		enum_field_types   type;
 
 		std::vector<char>  buffer;
 		short int          buffer_short;
@@ -0,0 +1,148 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "statement_cache.h"
+
+#include <algorithm>
+
+
+MariaDBStatementCache::MariaDBStatementCache()
+{
+}
+
+
+MariaDBStatementCache::~MariaDBStatementCache(void)
+{
+	clear();
+}
+
+
+void MariaDBStatementCache::init(const std::size_t &max_statements, cache_metrics *metrics)
+{
+	capacity = max_statements;
+	metrics_ptr = metrics;
+}
+
+
+std::vector<MariaDBStatement> *MariaDBStatementCache::get(const std::string &callname)
+{
+	auto entries_itr = entries.find(callname);
+	if (entries_itr == entries.end())
+	{
+		if (metrics_ptr)
+		{
+			metrics_ptr->misses.fetch_add(1, std::memory_order_relaxed);
+		}
+		return nullptr;
+	}
+	if (metrics_ptr)
+	{
+		metrics_ptr->hits.fetch_add(1, std::memory_order_relaxed);
+	}
+	lru.splice(lru.begin(), lru, entries_itr->second);
+	return &entries_itr->second->second;
+}
+
+
+std::vector<MariaDBStatement> *MariaDBStatementCache::find(const std::string &callname)
+{
+	auto entries_itr = entries.find(callname);
+	if (entries_itr == entries.end())
+	{
+		return nullptr;
+	}
+	return &entries_itr->second->second;
+}
+
+
+std::vector<MariaDBStatement> &MariaDBStatementCache::insert(const std::string &callname, const std::size_t &statements_count)
+// A Call larger than Capacity still gets prepared, it just evicts everything else
+//   Session can only close its own Calls, budget held by other Sessions is exceeded by at most this Call
+{
+	erase(callname);
+	if (capacity > 0)
+	{
+		while ((!lru.empty()) && ((getPrepared() + statements_count) > capacity))
+		{
+			evict(std::prev(lru.end()));
+		}
+	}
+
+	lru.emplace_front(callname, std::vector<MariaDBStatement>());
+	// Sized once, MariaDBStatement owns raw MYSQL_STMT handles + must never be copied
+	lru.front().second.resize(statements_count);
+	entries.emplace(lru.front().first, lru.begin());
+	statements += statements_count;
+	if (metrics_ptr)
+	{
+		metrics_ptr->statements.fetch_add(static_cast<std::int64_t>(statements_count), std::memory_order_relaxed);
+	}
+	return lru.front().second;
+}
+
+
+bool MariaDBStatementCache::evictOldest()
+{
+	if (lru.size() < 2)
+	{
+		return false;
+	}
+	evict(std::prev(lru.end()));
+	return true;
+}
+
+
+void MariaDBStatementCache::erase(const std::string &callname)
+{
+	auto entries_itr = entries.find(callname);
+	if (entries_itr != entries.end())
+	{
+		auto entry_itr = entries_itr->second;
+		const std::size_t statements_count = entry_itr->second.size();
+		entries.erase(entries_itr);
+		lru.erase(entry_itr);  // Closes Statements
+		statements -= statements_count;
+		if (metrics_ptr)
+		{
+			metrics_ptr->statements.fetch_sub(static_cast<std::int64_t>(statements_count), std::memory_order_relaxed);
+		}
+	}
+}
+
+
+void MariaDBStatementCache::clear()
+{
+	entries.clear();
+	lru.clear();
+	if (metrics_ptr)
+	{
+		metrics_ptr->statements.fetch_sub(static_cast<std::int64_t>(statements), std::memory_order_relaxed);
+	}
+	statements = 0;
+}
+
+
+std::size_t MariaDBStatementCache::getPrepared() const
+{
+	if (metrics_ptr)
+	{
+		return static_cast<std::size_t>(std::max<std::int64_t>(metrics_ptr->statements.load(std::memory_order_relaxed), 0));
+	}
+	return statements;
+}
+
+
+void MariaDBStatementCache::evict(std::list<entry>::iterator entry_itr)
+{
+	const std::size_t statements_count = entry_itr->second.size();
+	entries.erase(entry_itr->first);
+	lru.erase(entry_itr);  // mysql_stmt_close, frees the Statement on Server
+	statements -= statements_count;
+	if (metrics_ptr)
+	{
+		metrics_ptr->statements.fetch_sub(static_cast<std::int64_t>(statements_count), std::memory_order_relaxed);
+		metrics_ptr->evictions.fetch_add(statements_count, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,58 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "statement.h"
+
+
+class MariaDBStatementCache
+// SQL_CUSTOM Prepared Statements of a Session, keyed by Call Name + kept in Least Recently Used order
+//   Capacity counts Statements not Calls (a Call can have multiple SQL Lines), oldest Calls are closed to make room
+//   Capacity is the Database wide budget, checked against cache_metrics::statements of every Session
+{
+public:
+	MariaDBStatementCache();
+	~MariaDBStatementCache();
+
+	// Shared by all Sessions of a Database
+	struct cache_metrics
+	{
+		std::atomic<std::uint64_t> hits{0};
+		std::atomic<std::uint64_t> misses{0};
+		std::atomic<std::uint64_t> evictions{0};  // Statements closed to stay within Capacity / max_prepared_stmt_count
+		std::atomic<std::int64_t> statements{0};  // Currently prepared
+	};
+
+	void init(const std::size_t &max_statements, cache_metrics *metrics);  // 0 = Unlimited, metrics shared by all Sessions
+
+	std::vector<MariaDBStatement> *get(const std::string &callname);  // Marks as most recently used, nullptr if not cached
+	std::vector<MariaDBStatement> *find(const std::string &callname);  // Lookup only, no Metrics / LRU update
+	std::vector<MariaDBStatement> &insert(const std::string &callname, const std::size_t &statements_count);
+
+	bool evictOldest();  // Keeps most recently used Call, false if nothing left to evict
+	void erase(const std::string &callname);
+	void clear();        // Statements are gone on Server i.e Reconnect / mysql_reset_connection
+
+private:
+	typedef std::pair<std::string, std::vector<MariaDBStatement>> entry;
+	std::list<entry> lru;  // Front = most recently used
+	std::unordered_map<std::string_view, std::list<entry>::iterator> entries;  // Keys point into lru
+
+	std::size_t capacity = 0;
+	std::size_t statements = 0;
+	cache_metrics *metrics_ptr = nullptr;
+
+	void evict(std::list<entry>::iterator entry_itr);
+	std::size_t getPrepared() const;  // All Sessions of the Database
+};
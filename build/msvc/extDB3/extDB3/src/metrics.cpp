@@ -0,0 +1,98 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "metrics.h"
+
+
+thread_local std::atomic<std::uint64_t> *MetricsBlockedScope::counter = nullptr;
+thread_local int MetricsBlockedScope::depth = 0;
+
+
+const std::uint64_t MetricsHistogram::BUCKET_BOUNDS[MetricsHistogram::BUCKETS] = {100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 1000000, UINT64_MAX};
+
+
+void MetricsHistogram::record(const std::uint64_t &microseconds)
+{
+	int bucket = 0;
+	while (microseconds > BUCKET_BOUNDS[bucket])
+	{
+		++bucket;
+	}
+	buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+	sum.fetch_add(microseconds, std::memory_order_relaxed);
+	count.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void MetricsHistogram::record(const std::chrono::steady_clock::time_point &start)
+{
+	record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
+}
+
+
+std::uint64_t MetricsHistogram::getCount() const
+{
+	return count.load(std::memory_order_relaxed);
+}
+
+
+std::uint64_t MetricsHistogram::getSum() const
+{
+	return sum.load(std::memory_order_relaxed);
+}
+
+
+void MetricsHistogram::toString(std::string &result) const
+{
+	result += "[" + std::to_string(count.load(std::memory_order_relaxed)) + "," + std::to_string(sum.load(std::memory_order_relaxed)) + ",[";
+	for (int i = 0; i < BUCKETS; ++i)
+	{
+		if (i > 0)
+		{
+			result += ",";
+		}
+		result += std::to_string(buckets[i].load(std::memory_order_relaxed));
+	}
+	result += "]]";
+}
+
+
+void MetricsHistogram::boundsToString(std::string &result)
+// Overflow Bucket reported as -1
+{
+	result += "[";
+	for (int i = 0; i < BUCKETS; ++i)
+	{
+		if (i > 0)
+		{
+			result += ",";
+		}
+		result += (BUCKET_BOUNDS[i] == UINT64_MAX) ? "-1" : std::to_string(BUCKET_BOUNDS[i]);
+	}
+	result += "]";
+}
+
+
+MetricsBlockedScope::MetricsBlockedScope()
+{
+	active = ((counter != nullptr) && (depth++ == 0));
+	if (active)
+	{
+		start = std::chrono::steady_clock::now();
+	}
+}
+
+
+MetricsBlockedScope::~MetricsBlockedScope(void)
+{
+	if (counter != nullptr)
+	{
+		--depth;
+	}
+	if (active)
+	{
+		counter->fetch_add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()), std::memory_order_relaxed);
+	}
+}
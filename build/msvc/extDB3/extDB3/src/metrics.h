@@ -0,0 +1,53 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+
+class MetricsHistogram
+// Fixed Bucket Latency Histogram in Microseconds
+//   record is lock-free, 3 relaxed atomic adds. Readers may see a count slightly ahead of buckets
+{
+public:
+	static const int BUCKETS = 12;
+	static const std::uint64_t BUCKET_BOUNDS[BUCKETS];  // Upper Bounds, Last Bucket = Overflow
+
+	void record(const std::uint64_t &microseconds);
+	void record(const std::chrono::steady_clock::time_point &start);
+
+	std::uint64_t getCount() const;
+	std::uint64_t getSum() const;
+
+	// [Count,Sum,[Bucket,...]]
+	void toString(std::string &result) const;
+	static void boundsToString(std::string &result);
+
+private:
+	std::atomic<std::uint64_t> buckets[BUCKETS] = {};
+	std::atomic<std::uint64_t> count{0};
+	std::atomic<std::uint64_t> sum{0};
+};
+
+
+class MetricsBlockedScope
+// RAII, adds time the current Worker Thread spends blocked on Database I/O to its Lane counter
+//   Nested scopes only count once, threads without a counter (Game Thread) are ignored
+{
+public:
+	MetricsBlockedScope();
+	~MetricsBlockedScope();
+
+	static thread_local std::atomic<std::uint64_t> *counter;  // Microseconds, set by Executor for its Worker Threads
+
+private:
+	static thread_local int depth;
+	bool active;
+	std::chrono::steady_clock::time_point start;
+};
@@ -5,8 +5,14 @@
 
 #pragma once
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "../abstract_ext.h"
 
+class Executor;
+
 class AbstractProtocol
 {
 public:
@@ -16,5 +22,30 @@ public:
 	virtual bool init(AbstractExt *extension, const std::string &database_id, const std::string &init_str)=0;
 	virtual bool callProtocol(std::string input_str, std::string &result, const bool async_method, const unsigned int unique_id=1)=0;
 
+	// Sync Calls, Input still points into Arma's buffer
+	//   Default makes the one owned copy, Protocols that can parse a view in place should override this
+	virtual bool callProtocol(std::string_view input_str, std::string &result, const bool async_method, const unsigned int unique_id=1)
+	{
+		return callProtocol(std::string(input_str), result, async_method, unique_id);
+	};
+
+	// RVExtensionArgs, Input already split into Tokens by Arma
+	//   Default rebuilds input string, Protocols that tokenize input should override this
+	virtual bool callProtocol(std::vector<std::string> &tokens, std::string &result, const bool async_method, const unsigned int unique_id=1)
+	{
+		std::string input_str;
+		for (auto &token : tokens)
+		{
+			input_str += token;
+			input_str += ':';
+		}
+		if (!input_str.empty())
+		{
+			input_str.pop_back();
+		}
+		return callProtocol(std::move(input_str), result, async_method, unique_id);
+	};
+
 	AbstractExt *extension_ptr;
+	Executor *lane_ptr = nullptr;  // Lane running this Protocol's calls
 };
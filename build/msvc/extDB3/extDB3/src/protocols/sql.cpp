@@ -135,6 +135,16 @@ bool SQL::callProtocol(std::string input_str, std::string &result, const bool as
 		extension_ptr->logger->error("extDB3: SQL: Error MariaDBQueryException: Input: {0}", input_str);
 		result = "[0,\"Error MariaDBQueryException Exception\"]";
 	}
+	catch (MariaDBPoolException &e)
+	{
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBPoolException: {0}", e.what());
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBPoolException: Input: {0}", input_str);
+		#endif
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBPoolException: {0}", e.what());
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBPoolException: Input: {0}", input_str);
+		result = "[0,\"Error MariaDBPoolException Exception\"]";
+	}
 	catch (MariaDBConnectorException &e)
 	{
 		#ifdef DEBUG_TESTING
@@ -6,6 +6,9 @@
 #include "sql_custom.h"
 
 #include <algorithm>
+#include <charconv>
+#include <limits>
+#include <string_view>
 #include <thread>
 
 #include <boost/algorithm/string.hpp>
@@ -13,8 +16,10 @@
 #include <boost/filesystem.hpp>
 #include <boost/optional/optional.hpp>
 #include <boost/property_tree/ini_parser.hpp>
+#include <mariadb/mysqld_error.h>
 
 #include "../mariaDB/exceptions.h"
+#include "../mariaDB/result_stream.h"
 #include "../md5/md5.h"
 
 #include "../sqfparser.h"
@@ -217,6 +222,22 @@ bool SQL_CUSTOM::loadConfig(boost::filesystem::path &config_path)
 							{
 								option.mysql_escape = true;
 							}
+							else if	(boost::algorithm::iequals(sub_token, std::string("int")) == 1)
+							{
+								option.native_type = sql_option::NATIVE_INT;
+							}
+							else if	(boost::algorithm::iequals(sub_token, std::string("bigint")) == 1)
+							{
+								option.native_type = sql_option::NATIVE_BIGINT;
+							}
+							else if	(boost::algorithm::iequals(sub_token, std::string("double")) == 1)
+							{
+								option.native_type = sql_option::NATIVE_DOUBLE;
+							}
+							else if	(boost::algorithm::iequals(sub_token, std::string("bool_native")) == 1)
+							{
+								option.native_type = sql_option::NATIVE_BOOL;
+							}
 							else
 							{
 								try
@@ -340,6 +361,10 @@ bool SQL_CUSTOM::loadConfig(boost::filesystem::path &config_path)
 			calls[section.first].returnInsertIDString = ptree.get(path, false);
 			ptree.get_child(section.first).erase("Return InsertID String");
 
+			path = section.first + ".Streaming";
+			calls[section.first].streaming = ptree.get(path, false);
+			ptree.get_child(section.first).erase("Streaming");
+
 			path = section.first + ".Strip Chars";
 			calls[section.first].strip_chars = ptree.get(path, strip_chars);
 			ptree.get_child(section.first).erase("Strip Chars");
@@ -388,7 +413,7 @@ bool SQL_CUSTOM::loadConfig(boost::filesystem::path &config_path)
 	}
 }
 
-bool SQL_CUSTOM::query(std::string &input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, std::vector<std::string> &tokens, MariaDBSession &session, std::string &insertID, std::unordered_map<std::string, call_struct>::iterator &calls_itr)
+bool SQL_CUSTOM::query(std::string_view input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, std::vector<std::string> &tokens, MariaDBSession &session, std::string &insertID, std::unordered_map<std::string, call_struct>::iterator &calls_itr, const bool &stream)
 {
 	// -------------------
 	// Raw SQL
@@ -413,11 +438,11 @@ bool SQL_CUSTOM::query(std::string &input_str, std::string &result, std::vector<
 					switch (calls_itr->second.strip_chars_mode)
 					{
 						case 2: // Log + Error
-							extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, tmp_str);
+							extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", std::string(input_str), tmp_str);
 							result = "[0,\"Error Strip Char Found\"]";
 							return false;
 						case 1: // Log
-							extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, tmp_str);
+							extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", std::string(input_str), tmp_str);
 					}
 					tmp_str = std::move(stripped_str);
 				}
@@ -493,17 +518,24 @@ bool SQL_CUSTOM::query(std::string &input_str, std::string &result, std::vector<
 		{
 			auto &session_query_itr = session.data->query;
 			session.data->query.send(sql_str);
-			//session.data->query.get(insertID, result_vec); // TODO: OUTPUT OPTIONS SUPPORT
-			session.data->query.get(sql.output_options, calls_itr->second.strip_chars, calls_itr->second.strip_chars_mode, insertID, result_vec);
+			if ((stream) && (&sql == &calls_itr->second.sql.back()))
+			{
+				// Rows are left on the Server, read by MariaDBResultStream
+				result_vec.clear();
+				session.data->query.use(sql.output_options, insertID);
+			} else {
+				//session.data->query.get(insertID, result_vec); // TODO: OUTPUT OPTIONS SUPPORT
+				session.data->query.get(sql.output_options, calls_itr->second.strip_chars, calls_itr->second.strip_chars_mode, insertID, result_vec);
+			}
 		}
 		catch (MariaDBQueryException &e)
 		{
 			#ifdef DEBUG_TESTING
 				extension_ptr->console->error("extDB3: SQL: Error MariaDBQueryException: {0}", e.what());
-				extension_ptr->console->error("extDB3: SQL: Error MariaDBQueryException: Input: {0}", input_str);
+				extension_ptr->console->error("extDB3: SQL: Error MariaDBQueryException: Input: {0}", std::string(input_str));
 			#endif
 			extension_ptr->logger->error("extDB3: SQL: Error MariaDBQueryException: {0}", e.what());
-			extension_ptr->logger->error("extDB3: SQL: Error MariaDBQueryException: Input: {0}", input_str);
+			extension_ptr->logger->error("extDB3: SQL: Error MariaDBQueryException: Input: {0}", std::string(input_str));
 			result = "[0,\"Error MariaDBQueryException Exception\"]";
 			return false;
 		}
@@ -511,20 +543,32 @@ bool SQL_CUSTOM::query(std::string &input_str, std::string &result, std::vector<
 	return true;
 }
 
-bool SQL_CUSTOM::preparedStatementPrepare(std::string &input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr)
+bool SQL_CUSTOM::preparedStatementPrepare(std::string_view input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr)
 {
 	try
 	{
-		if (session.data->statements.count(callname) == 0)
+		if (session.data->statements.get(callname) == nullptr)
 		{
-			session.data->statements[callname].resize(calls_itr->second.sql.size());
+			std::vector<MariaDBStatement> &session_statements = session.data->statements.insert(callname, calls_itr->second.sql.size());
 
 			for (int sql_index = 0; sql_index < calls_itr->second.sql.size(); ++sql_index)
 			{
-				session_statement_itr = &session.data->statements[callname][sql_index];
+				session_statement_itr = &session_statements[sql_index];
 				session_statement_itr->init(session.data->connector);
 				session_statement_itr->create();
-				session_statement_itr->prepare(calls_itr->second.sql[sql_index].sql);
+				try
+				{
+					session_statement_itr->prepare(calls_itr->second.sql[sql_index].sql);
+				}
+				catch (MariaDBStatementException0 &)
+				{
+					// Server max_prepared_stmt_count reached, close this Session's least recently used Call + retry once
+					if ((mysql_errno(session.data->connector.mysql_ptr) != ER_MAX_PREPARED_STMT_COUNT_REACHED) || (!session.data->statements.evictOldest()))
+					{
+						throw;
+					}
+					session_statement_itr->prepare(calls_itr->second.sql[sql_index].sql);
+				}
 			}
 		}
 	}
@@ -532,10 +576,10 @@ bool SQL_CUSTOM::preparedStatementPrepare(std::string &input_str, std::string &r
 	{
 		#ifdef DEBUG_TESTING
 			extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException0: {0}", e.what());
-			extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", input_str);
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", std::string(input_str));
 		#endif
 		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: {0}", e.what());
-		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", input_str);
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", std::string(input_str));
 		result = "[0,\"Error MariaDBStatementException0 Exception\"]";
 		session.resetSession();
 		return false;
@@ -544,10 +588,10 @@ bool SQL_CUSTOM::preparedStatementPrepare(std::string &input_str, std::string &r
 	{
 		#ifdef DEBUG_TESTING
 			extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException1: {0}", e.what());
-			extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", input_str);
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", std::string(input_str));
 		#endif
 		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: {0}", e.what());
-		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", input_str);
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", std::string(input_str));
 		result = "[0,\"Error MariaDBStatementException1 Exception\"]";
 		session.resetSession();
 		return false;
@@ -556,10 +600,10 @@ bool SQL_CUSTOM::preparedStatementPrepare(std::string &input_str, std::string &r
 	{
 		#ifdef DEBUG_TESTING
 			extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: {0}", e.what());
-			extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: Input: {0}", input_str);
+			extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: Input: {0}", std::string(input_str));
 		#endif
 		extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: {0}", e.what());
-		extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: Input: {0}", input_str);
+		extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: Input: {0}", std::string(input_str));
 		result = "[0,\"Error extDB3Exception Exception\"]";
 		session.resetSession();
 		return false;
@@ -567,45 +611,146 @@ bool SQL_CUSTOM::preparedStatementPrepare(std::string &input_str, std::string &r
 	return true;
 }
 
-bool SQL_CUSTOM::preparedStatementExecute(std::string &input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr, std::vector<std::string> &tokens, std::string &insertID)
+const char *SQL_CUSTOM::nativeTypeName(const int &native_type)
 {
+	switch (native_type)
+	{
+		case sql_option::NATIVE_INT:
+			return "int";
+		case sql_option::NATIVE_BIGINT:
+			return "bigint";
+		case sql_option::NATIVE_DOUBLE:
+			return "double";
+		case sql_option::NATIVE_BOOL:
+			return "bool_native";
+	}
+	return "string";
+}
+
+
+void SQL_CUSTOM::ownValue(MariaDBStatement::mysql_bind_param &param)
+// INPUT Option is about to rewrite value, copies it into param's own buffer (once)
+{
+	if (param.value.data() != param.buffer.data())
+	{
+		param.buffer.assign(param.value.data(), param.value.size());
+		param.value = param.buffer;
+	}
+}
+
+
+bool SQL_CUSTOM::nativeConvert(const int &native_type, MariaDBStatement::mysql_bind_param &param)
+// INPUT int / bigint / double / bool_native, parsed once here + bound as MYSQL_TYPE_LONG / LONGLONG / DOUBLE / TINY
+{
+	std::string_view value(param.value);
+	while ((!value.empty()) && (value.front() == ' '))
+	{
+		value.remove_prefix(1);
+	}
+	while ((!value.empty()) && (value.back() == ' '))
+	{
+		value.remove_suffix(1);
+	}
+	if (value.empty())
+	{
+		return false;
+	}
+
+	switch (native_type)
+	{
+		case sql_option::NATIVE_INT:
+		case sql_option::NATIVE_BIGINT:
+		{
+			long long number;
+			const auto parsed = std::from_chars(value.data(), value.data() + value.size(), number);
+			if ((parsed.ec != std::errc()) || (parsed.ptr != (value.data() + value.size())))
+			{
+				return false;
+			}
+			if (native_type == sql_option::NATIVE_INT)
+			{
+				if ((number < std::numeric_limits<int>::min()) || (number > std::numeric_limits<int>::max()))
+				{
+					return false;
+				}
+				param.buffer_long = static_cast<int>(number);
+				param.type = MYSQL_TYPE_LONG;
+			} else {
+				param.buffer_longlong = number;
+				param.type = MYSQL_TYPE_LONGLONG;
+			}
+			return true;
+		}
+		case sql_option::NATIVE_DOUBLE:
+		{
+			double number;
+			const auto parsed = std::from_chars(value.data(), value.data() + value.size(), number);
+			if ((parsed.ec != std::errc()) || (parsed.ptr != (value.data() + value.size())))
+			{
+				return false;
+			}
+			param.buffer_double = number;
+			param.type = MYSQL_TYPE_DOUBLE;
+			return true;
+		}
+		case sql_option::NATIVE_BOOL:
+		{
+			if ((value == "1") || (boost::algorithm::iequals(value, "true")))
+			{
+				param.buffer_tiny = 1;
+			}
+			else if ((value == "0") || (boost::algorithm::iequals(value, "false")))
+			{
+				param.buffer_tiny = 0;
+			} else {
+				return false;
+			}
+			param.type = MYSQL_TYPE_TINY;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+bool SQL_CUSTOM::preparedStatementExecute(std::string_view input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr, std::vector<std::string> &tokens, std::string &insertID, const bool &stream)
+// Returns true + sets result if Input is rejected (Strip Char / Invalid Input Type), nothing is executed
+{
+	result.clear(); // Error from a previous attempt
 	for (int sql_index = 0; sql_index < calls_itr->second.sql.size(); ++sql_index)
 	{
-		std::vector<MariaDBStatement::mysql_bind_param> processed_inputs;
+		// Param vector is reused per Statement, values view the Input Tokens + are only copied when an INPUT Option rewrites them
+		session_statement_itr = &(*session.data->statements.find(callname))[sql_index];
+		std::vector<MariaDBStatement::mysql_bind_param> &processed_inputs = session_statement_itr->params;
 		processed_inputs.resize(calls_itr->second.sql[sql_index].input_options.size());
 		for (int i = 0; i < processed_inputs.size(); ++i)
 		{
 			processed_inputs[i].type = MYSQL_TYPE_VARCHAR;
-			processed_inputs[i].buffer = tokens[calls_itr->second.sql[sql_index].input_options[i].value_number];
-			processed_inputs[i].length = processed_inputs[i].buffer.size();
-			if (calls_itr->second.sql[sql_index].input_options[i].strip)
+			processed_inputs[i].value = tokens[calls_itr->second.sql[sql_index].input_options[i].value_number];
+			if ((calls_itr->second.sql[sql_index].input_options[i].strip) && (processed_inputs[i].value.find_first_of(calls_itr->second.strip_chars) != std::string_view::npos))
 			{
-				std::string stripped_str = processed_inputs[i].buffer;
-				for (auto &strip_char : calls_itr->second.strip_chars)
+				switch (calls_itr->second.strip_chars_mode)
 				{
-					boost::erase_all(stripped_str, std::string(1, strip_char));
+					case 2: // Log + Error
+						extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", std::string(input_str), std::string(processed_inputs[i].value));
+						result = "[0,\"Error Strip Char Found\"]";
+						return true;
+					case 1: // Log
+						extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", std::string(input_str), std::string(processed_inputs[i].value));
 				}
-				if (stripped_str != processed_inputs[i].buffer)
+				ownValue(processed_inputs[i]);
+				for (auto &strip_char : calls_itr->second.strip_chars)
 				{
-					switch (calls_itr->second.strip_chars_mode)
-					{
-						case 2: // Log + Error
-							extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, processed_inputs[i].buffer);
-							result = "[0,\"Error Strip Char Found\"]";
-							return true;
-						case 1: // Log
-							extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, processed_inputs[i].buffer);
-					}
-					processed_inputs[i].buffer = std::move(stripped_str);
-					processed_inputs[i].length = processed_inputs[i].buffer.size();
+					boost::erase_all(processed_inputs[i].buffer, std::string(1, strip_char));
 				}
+				processed_inputs[i].value = processed_inputs[i].buffer;
 			}
 			if (calls_itr->second.sql[sql_index].input_options[i].beguidConvert)
 			{
 				std::string beguid_str;
 				try
 				{
-					int64_t steamID = std::stoll(processed_inputs[i].buffer, nullptr);
+					int64_t steamID = std::stoll(std::string(processed_inputs[i].value), nullptr);
 					std::stringstream bestring;
 					int8_t i = 0, parts[8] = { 0 };
 					do parts[i++] = steamID & 0xFF;
@@ -620,71 +765,97 @@ bool SQL_CUSTOM::preparedStatementExecute(std::string &input_str, std::string &r
 				{
 					beguid_str = "ERROR";
 				}
-				processed_inputs[i].buffer = beguid_str;
-				processed_inputs[i].length = beguid_str.size();
+				processed_inputs[i].buffer = std::move(beguid_str);
+				processed_inputs[i].value = processed_inputs[i].buffer;
 			}
 			if (calls_itr->second.sql[sql_index].input_options[i].boolConvert)
 			{
-				if (boost::algorithm::iequals(processed_inputs[i].buffer, std::string("true")) == 1)
+				if (boost::algorithm::iequals(processed_inputs[i].value, std::string_view("true")) == 1)
 				{
-					processed_inputs[i].buffer = "1";
+					processed_inputs[i].value = "1";
 				} else {
-					processed_inputs[i].buffer = "0";
+					processed_inputs[i].value = "0";
 				}
-				processed_inputs[i].length = processed_inputs[i].buffer.size();
 			}
 			if (calls_itr->second.sql[sql_index].input_options[i].nullConvert)
 			{
-				if (processed_inputs[i].buffer.empty())
+				if (processed_inputs[i].value.empty())
 				{
 					processed_inputs[i].type = MYSQL_TYPE_NULL;
 				}
 			}
 			if (calls_itr->second.sql[sql_index].input_options[i].string_remove_escape_quotes)
 			{
+					ownValue(processed_inputs[i]);
 					boost::replace_all(processed_inputs[i].buffer, "\"\"", "\"");
-					processed_inputs[i].length = processed_inputs[i].buffer.size();
+					processed_inputs[i].value = processed_inputs[i].buffer;
 			}
 			if (calls_itr->second.sql[sql_index].input_options[i].string_add_escape_quotes)
 			{
+					ownValue(processed_inputs[i]);
 					boost::replace_all(processed_inputs[i].buffer, "\"", "\"\"");
-					processed_inputs[i].length = processed_inputs[i].buffer.size();
+					processed_inputs[i].value = processed_inputs[i].buffer;
 			}
 			if (calls_itr->second.sql[sql_index].input_options[i].string_remove_quotes)
 			{
+					ownValue(processed_inputs[i]);
 					boost::replace_all(processed_inputs[i].buffer, "\"", "");
 					boost::replace_all(processed_inputs[i].buffer, "\'", "");
-					processed_inputs[i].length = processed_inputs[i].buffer.size();
+					processed_inputs[i].value = processed_inputs[i].buffer;
 			}
 			if (calls_itr->second.sql[sql_index].input_options[i].stringify)
 			{
-					processed_inputs[i].buffer = "\"" + processed_inputs[i].buffer + "\"";
-					processed_inputs[i].length = processed_inputs[i].buffer.size();
+					ownValue(processed_inputs[i]);
+					processed_inputs[i].buffer.insert(processed_inputs[i].buffer.begin(), '"');
+					processed_inputs[i].buffer.push_back('"');
+					processed_inputs[i].value = processed_inputs[i].buffer;
 			}
 			if (calls_itr->second.sql[sql_index].input_options[i].stringify2)
 			{
-					processed_inputs[i].buffer = "'" + processed_inputs[i].buffer + "'";
-					processed_inputs[i].length = processed_inputs[i].buffer.size();
+					ownValue(processed_inputs[i]);
+					processed_inputs[i].buffer.insert(processed_inputs[i].buffer.begin(), '\'');
+					processed_inputs[i].buffer.push_back('\'');
+					processed_inputs[i].value = processed_inputs[i].buffer;
 			}
 			if (calls_itr->second.sql[sql_index].input_options[i].timeConvert)
 			{
 				processed_inputs[i].type = MYSQL_TYPE_DATETIME;
 			}
+			if ((calls_itr->second.sql[sql_index].input_options[i].native_type != sql_option::NATIVE_NONE) && (processed_inputs[i].type != MYSQL_TYPE_NULL))
+			{
+				if (!nativeConvert(calls_itr->second.sql[sql_index].input_options[i].native_type, processed_inputs[i]))
+				{
+					// Retrying won't change the Input, reported straight back to SQF. Value itself is only logged, it could break the SQF Array
+					const std::string input_location = "SQL" + std::to_string(sql_index + 1) + "_INPUTS Value " + std::to_string(calls_itr->second.sql[sql_index].input_options[i].value_number);
+					const std::string type_name = nativeTypeName(calls_itr->second.sql[sql_index].input_options[i].native_type);
+					#ifdef DEBUG_TESTING
+						extension_ptr->console->warn("extDB3: SQL_CUSTOM: Error Invalid Input Type: Expected {0} Got: {1} for {2} Input: {3}", type_name, std::string(processed_inputs[i].value), input_location, std::string(input_str));
+					#endif
+					extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Invalid Input Type: Expected {0} Got: {1} for {2} Input: {3}", type_name, std::string(processed_inputs[i].value), input_location, std::string(input_str));
+					result = "[0,\"Error Invalid Input Type: Expected " + type_name + " for " + input_location + "\"]";
+					return true;
+				}
+			}
 		}
 		try
 		{
-			session_statement_itr = &session.data->statements[callname][sql_index];
 			session_statement_itr->bindParams(processed_inputs);
-			session_statement_itr->execute(calls_itr->second.sql[sql_index].output_options, calls_itr->second.strip_chars, calls_itr->second.strip_chars_mode, insertID, result_vec);
+			if ((stream) && (sql_index == (calls_itr->second.sql.size() - 1)))
+			{
+				// Rows are left on the Server, read by MariaDBResultStream
+				session_statement_itr->execute(calls_itr->second.sql[sql_index].output_options, insertID, false);
+			} else {
+				session_statement_itr->execute(calls_itr->second.sql[sql_index].output_options, calls_itr->second.strip_chars, calls_itr->second.strip_chars_mode, insertID, result_vec);
+			}
 		}
 		catch (MariaDBStatementException0 &e)
 		{
 			#ifdef DEBUG_TESTING
 				extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException0: {0}", e.what());
-				extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", input_str);
+				extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", std::string(input_str));
 			#endif
 			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: {0}", e.what());
-			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", input_str);
+			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", std::string(input_str));
 			result = "[0,\"Error MariaDBStatementException0 Exception\"]";
 			session.resetSession();
 			return false;
@@ -693,10 +864,10 @@ bool SQL_CUSTOM::preparedStatementExecute(std::string &input_str, std::string &r
 		{
 			#ifdef DEBUG_TESTING
 				extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException1: {0}", e.what());
-				extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", input_str);
+				extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", std::string(input_str));
 			#endif
 			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: {0}", e.what());
-			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", input_str);
+			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", std::string(input_str));
 			result = "[0,\"Error MariaDBStatementException1 Exception\"]";
 			session.resetSession();
 			return false;
@@ -705,10 +876,10 @@ bool SQL_CUSTOM::preparedStatementExecute(std::string &input_str, std::string &r
 		{
 			#ifdef DEBUG_TESTING
 				extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: {0}", e.what());
-				extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: Input: {0}", input_str);
+				extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: Input: {0}", std::string(input_str));
 			#endif
 			extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: {0}", e.what());
-			extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: Input: {0}", input_str);
+			extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: Input: {0}", std::string(input_str));
 			result = "[0,\"Error extDB3Exception Exception\"]";
 			session.resetSession();
 			return false;
@@ -717,69 +888,113 @@ bool SQL_CUSTOM::preparedStatementExecute(std::string &input_str, std::string &r
 	return true;
 }
 
-bool SQL_CUSTOM::callProtocol (std::string input_str, std::string &result, const bool async_method, const unsigned int unique_id)
+bool SQL_CUSTOM::callProtocol(std::string input_str, std::string &result, const bool async_method, const unsigned int unique_id)
+{
+	return callProtocol(std::string_view(input_str), result, async_method, unique_id);
+}
+
+
+bool SQL_CUSTOM::callProtocol(std::string_view input_str, std::string &result, const bool async_method, const unsigned int unique_id)
+// Sync Calls pass a view into Arma's buffer, only Callname + Tokens are copied
 {
 	#ifdef DEBUG_TESTING
-		extension_ptr->console->info("extDB3: SQL_CUSTOM: Trace: UniqueID: {0} Input: {1}", unique_id, input_str);
+		extension_ptr->console->info("extDB3: SQL_CUSTOM: Trace: UniqueID: {0} Input: {1}", unique_id, std::string(input_str));
 	#endif
 	#ifdef DEBUG_LOGGING
-		extension_ptr->logger->info("extDB3: SQL_CUSTOM: Trace: UniqueID: {0} Input: {1}", unique_id, input_str);
+		extension_ptr->logger->info("extDB3: SQL_CUSTOM: Trace: UniqueID: {0} Input: {1}", unique_id, std::string(input_str));
 	#endif
 
 	std::string callname;
-	//std::string tokens_str;
-	std::string insertID = "0";
-	const std::string::size_type found = input_str.find(":");
-	if (found != std::string::npos)
+	const std::string_view::size_type found = input_str.find(':');
+	if (found != std::string_view::npos)
 	{
-		callname = input_str.substr(0, found);
-		//tokens_str = input_str.substr(found+1);
+		callname = std::string(input_str.substr(0, found));
 	}	else {
-		callname = input_str;
+		callname = std::string(input_str);
 	}
 	std::unordered_map<std::string, SQL_CUSTOM::call_struct>::iterator calls_itr = calls.find(callname);
 	if (calls_itr == calls.end())
 	{
 		// NO CALLNAME FOUND IN PROTOCOL
 		result = "[0,\"Error No Custom Call Not Found\"]";
-		extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error No Custom Call Not Found: Input String {0}", input_str);
+		extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error No Custom Call Not Found: Input String {0}", std::string(input_str));
 		extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error No Custom Call Not Found: Callname {0}", callname);
 		#ifdef DEBUG_TESTING
-			extension_ptr->console->warn("extDB3: SQL_CUSTOM: Error No Custom Call Not Found: Input String {0}", input_str);
+			extension_ptr->console->warn("extDB3: SQL_CUSTOM: Error No Custom Call Not Found: Input String {0}", std::string(input_str));
 			extension_ptr->console->warn("extDB3: SQL_CUSTOM: Error No Custom Call Not Found: Callname {0}", callname);
 		#endif
 		return true;
 	}
 
-	std::vector<std::vector<std::string>> result_vec;
-	try
+	std::vector<std::string> tokens;
+	if (calls_itr->second.input_sqf_parser)
 	{
-		MariaDBSession session(database_pool);
-
-		std::vector<std::string> tokens;
-		if (calls_itr->second.input_sqf_parser)
+		if (found != std::string_view::npos)
 		{
-			if (found != std::string::npos)
-			{
-				tokens.push_back(callname);
-				std::string tokens_str = input_str.substr(found+1);
-				sqf::parser(tokens_str, tokens);
-			}
-		} else {
-			boost::split(tokens, input_str, boost::is_any_of(":"));
+			tokens.push_back(callname);
+			std::string tokens_str(input_str.substr(found+1));
+			sqf::parser(tokens_str, tokens);
 		}
+	} else {
+		boost::split(tokens, input_str, boost::is_any_of(":"));
+	}
+	return processCall(input_str, result, callname, calls_itr, tokens, async_method, unique_id);
+}
+
+bool SQL_CUSTOM::callProtocol(std::vector<std::string> &tokens, std::string &result, const bool async_method, const unsigned int unique_id)
+// RVExtensionArgs: tokens[0] = callname, tokens[1..] = inputs. No splitting / SQF Parser required
+{
+	if (tokens.empty())
+	{
+		result = "[0,\"Error No Custom Call Not Found\"]";
+		extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error No Custom Call Not Found: No Callname");
+		return true;
+	}
 
+	std::string callname = tokens[0];
+	#ifdef DEBUG_TESTING
+		extension_ptr->console->info("extDB3: SQL_CUSTOM: Trace: UniqueID: {0} Callname: {1} Inputs: {2}", unique_id, callname, (tokens.size() - 1));
+	#endif
+	#ifdef DEBUG_LOGGING
+		extension_ptr->logger->info("extDB3: SQL_CUSTOM: Trace: UniqueID: {0} Callname: {1} Inputs: {2}", unique_id, callname, (tokens.size() - 1));
+	#endif
+
+	std::unordered_map<std::string, SQL_CUSTOM::call_struct>::iterator calls_itr = calls.find(callname);
+	if (calls_itr == calls.end())
+	{
+		// NO CALLNAME FOUND IN PROTOCOL
+		result = "[0,\"Error No Custom Call Not Found\"]";
+		extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error No Custom Call Not Found: Callname {0}", callname);
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->warn("extDB3: SQL_CUSTOM: Error No Custom Call Not Found: Callname {0}", callname);
+		#endif
+		return true;
+	}
+	return processCall(callname, result, callname, calls_itr, tokens, async_method, unique_id);
+}
+
+bool SQL_CUSTOM::processCall(std::string_view input_str, std::string &result, std::string &callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr, std::vector<std::string> &tokens, const bool &async_method, const unsigned int &unique_id)
+// Streaming Result is stored here + returns false for ASync Calls, so Ext doesn't store result over it
+//   One-Way Calls (unique_id 1) have nobody to read the Stream, so are always buffered
+{
+	std::string insertID = "0";
+	std::vector<std::vector<std::string>> result_vec;
+	const bool stream = ((calls_itr->second.streaming) && ((!async_method) || (unique_id > 1)));
+	try
+	{
 		if ((tokens.size()-1) != calls_itr->second.highest_input_value)
 		{
 			throw extDB3Exception("Config Invalid Number Number of Inputs Got " + std::to_string(tokens.size()-1) + " Expected " + std::to_string(calls_itr->second.highest_input_value));
 		}
 
+		MariaDBSession session(database_pool);
+
 		bool success = false;
 		if (!calls_itr->second.preparedStatement)
 		{
 			for (int i = 0; i <= calls_itr->second.num_of_retrys; ++i)
 			{
-				if (!query(input_str, result, result_vec, tokens, session, insertID, calls_itr))
+				if (!query(input_str, result, result_vec, tokens, session, insertID, calls_itr, stream))
 				{
 					// DO NOTHING
 				} else {
@@ -799,7 +1014,7 @@ bool SQL_CUSTOM::callProtocol (std::string input_str, std::string &result, const
 				{
 					// DO NOTHING
 				} else {
-					if (!preparedStatementExecute(input_str, result, result_vec, session, session_statement_itr, callname, calls_itr, tokens, insertID))
+					if (!preparedStatementExecute(input_str, result, result_vec, session, session_statement_itr, callname, calls_itr, tokens, insertID, stream))
 					{
 						// DO NOTHING
 					} else {
@@ -819,6 +1034,49 @@ bool SQL_CUSTOM::callProtocol (std::string input_str, std::string &result, const
 			extension_ptr->logger->error("extDB3: SQL: Error Max Retrys Reached");
 			return true;
 		}
+		if ((calls_itr->second.preparedStatement) && (!result.empty()))
+		{
+			// Input rejected by preparedStatementExecute
+			return true;
+		}
+		if (stream)
+		{
+			std::string header = "[1,[";
+			std::string footer = "]]";
+			if (calls_itr->second.returnInsertID)
+			{
+				header += insertID + ",[";
+				footer += "]";
+			} else if (calls_itr->second.returnInsertIDString)
+			{
+				header += "\"" + insertID + "\",[";
+				footer += "]";
+			}
+			MariaDBStatement *statement_ptr = nullptr;
+			if (calls_itr->second.preparedStatement)
+			{
+				statement_ptr = &session.data->statements.find(callname)->back();
+			}
+			std::unique_ptr<ResultStream> result_stream(new MariaDBResultStream(std::move(session), statement_ptr, calls_itr->second.strip_chars, calls_itr->second.strip_chars_mode,
+				std::move(header), std::move(footer), std::move(result_vec)));
+			result_stream->lane = lane_ptr;
+			const unsigned long stream_id = extension_ptr->saveResultStream((async_method ? unique_id : 0), std::move(result_stream));
+			if (stream_id == 0)
+			{
+				#ifdef DEBUG_TESTING
+					extension_ptr->console->error("extDB3: SQL_CUSTOM: Error Result Store Full, Streaming Result Discarded: {0}", callname);
+				#endif
+				extension_ptr->logger->error("extDB3: SQL_CUSTOM: Error Result Store Full, Streaming Result Discarded: {0}", callname);
+				result = "[0,\"Error Result Store Full\"]";
+				return true;
+			}
+			if (async_method)
+			{
+				return false;
+			}
+			result = "[2,\"" + std::to_string(stream_id) + "\"]";
+			return true;
+		}
 		result = "[1,[";
 		if (calls_itr->second.returnInsertID)
 		{
@@ -866,20 +1124,30 @@ bool SQL_CUSTOM::callProtocol (std::string input_str, std::string &result, const
 	{
 		#ifdef DEBUG_TESTING
 			extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: {0}", e.what());
-			extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: Input: {0}", input_str);
+			extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: Input: {0}", std::string(input_str));
 		#endif
 		extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: {0}", e.what());
-		extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: Input: {0}", input_str);
+		extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: Input: {0}", std::string(input_str));
 		result = "[0,\"Error extDB3Exception Exception\"]";
 	}
+	catch (MariaDBPoolException &e)
+	{
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBPoolException: {0}", e.what());
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBPoolException: Input: {0}", std::string(input_str));
+		#endif
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBPoolException: {0}", e.what());
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBPoolException: Input: {0}", std::string(input_str));
+		result = "[0,\"Error MariaDBPoolException Exception\"]";
+	}
 	catch (MariaDBConnectorException &e)
 	{
 		#ifdef DEBUG_TESTING
 			extension_ptr->console->error("extDB3: SQL: Error MariaDBConnectorException: {0}", e.what());
-			extension_ptr->console->error("extDB3: SQL: Error MariaDBConnectorException: Input: {0}", input_str);
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBConnectorException: Input: {0}", std::string(input_str));
 		#endif
 		extension_ptr->logger->error("extDB3: SQL: Error MariaDBConnectorException: {0}", e.what());
-		extension_ptr->logger->error("extDB3: SQL: Error MariaDBConnectorException: Input: {0}", input_str);
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBConnectorException: Input: {0}", std::string(input_str));
 		result = "[0,\"Error MariaDBConnectorException Exception\"]";
 	}
 	return true;
@@ -34,6 +34,7 @@ class SQL_CUSTOM: public AbstractProtocol
 			bool preparedStatement = false;
 			bool returnInsertID = false;
 			bool returnInsertIDString = false;
+			bool streaming = false;  // Last SQL Line rows are read from the Server as SQF fetches each 5: part
 
 			std::string strip_chars;
 			int strip_chars_mode = 0;
@@ -46,6 +47,8 @@ class SQL_CUSTOM: public AbstractProtocol
 		
 		bool init(AbstractExt *extension, const std::string &database_id, const std::string &options_str);
 		bool callProtocol(std::string input_str, std::string &result, const bool async_method, const unsigned int unique_id=1);
+		bool callProtocol(std::string_view input_str, std::string &result, const bool async_method, const unsigned int unique_id=1);
+		bool callProtocol(std::vector<std::string> &tokens, std::string &result, const bool async_method, const unsigned int unique_id=1);
 
 	private:
 		MariaDBPool *database_pool;
@@ -53,8 +56,12 @@ class SQL_CUSTOM: public AbstractProtocol
 
 		std::unordered_map<std::string, call_struct> calls;
 
-		bool query(std::string &input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, std::vector<std::string> &tokens, MariaDBSession &session, std::string &insertID, std::unordered_map<std::string, call_struct>::iterator &calls_itr);
-		bool preparedStatementPrepare(std::string &input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr);
-		bool preparedStatementExecute(std::string &input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr, std::vector<std::string> &tokens, std::string &insertID);
+		bool processCall(std::string_view input_str, std::string &result, std::string &callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr, std::vector<std::string> &tokens, const bool &async_method, const unsigned int &unique_id);
+		bool query(std::string_view input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, std::vector<std::string> &tokens, MariaDBSession &session, std::string &insertID, std::unordered_map<std::string, call_struct>::iterator &calls_itr, const bool &stream);
+		bool preparedStatementPrepare(std::string_view input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr);
+		static const char *nativeTypeName(const int &native_type);
+		static void ownValue(MariaDBStatement::mysql_bind_param &param);
+		static bool nativeConvert(const int &native_type, MariaDBStatement::mysql_bind_param &param);
+		bool preparedStatementExecute(std::string_view input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr, std::vector<std::string> &tokens, std::string &insertID, const bool &stream);
 		bool loadConfig(boost::filesystem::path &config_path);
 };
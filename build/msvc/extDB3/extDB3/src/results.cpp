@@ -0,0 +1,402 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "results.h"
+
+#include <algorithm>
+
+
+ResultStore::ResultStore()
+{
+	for (auto &segment : segments)
+	{
+		segment.store(nullptr, std::memory_order_relaxed);
+	}
+}
+
+
+ResultStore::~ResultStore(void)
+{
+	for (auto &segment : segments)
+	{
+		delete[] segment.load(std::memory_order_relaxed);
+	}
+}
+
+
+std::int64_t ResultStore::now()
+{
+	return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+void ResultStore::setLimits(const std::chrono::seconds &result_ttl, const std::size_t &result_max_bytes, const std::chrono::seconds &result_stream_ttl)
+{
+	ttl.store(result_ttl.count(), std::memory_order_relaxed);
+	max_bytes.store(result_max_bytes, std::memory_order_relaxed);
+	stream_ttl.store(result_stream_ttl.count(), std::memory_order_relaxed);
+}
+
+
+ResultStore::slot *ResultStore::getSlot(const std::size_t &index)
+{
+	return &(segments[index / SEGMENT_SIZE].load(std::memory_order_acquire)[index % SEGMENT_SIZE]);
+}
+
+
+bool ResultStore::grow(const std::size_t &current_count)
+// Adds another segment of slots, returns false if Result Store is Full
+{
+	if (current_count >= MAX_SEGMENTS)
+	{
+		return false;
+	}
+	slot *expected = nullptr;
+	slot *segment = new slot[SEGMENT_SIZE];
+	if (!segments[current_count].compare_exchange_strong(expected, segment))
+	{
+		delete[] segment; // Another thread already added this segment
+	}
+	std::size_t count = current_count;
+	segments_count.compare_exchange_strong(count, current_count + 1);
+	return true;
+}
+
+
+unsigned long ResultStore::allocate(const std::uint64_t &status)
+// Claims a FREE slot and bumps its generation, returns 0 if Result Store is Full
+{
+	while (true)
+	{
+		const std::size_t count = segments_count.load(std::memory_order_acquire);
+		const std::size_t capacity = count * SEGMENT_SIZE;
+		if (capacity > 0)
+		{
+			const std::size_t start = allocate_cursor.load(std::memory_order_relaxed);
+			for (std::size_t i = 0; i < capacity; ++i)
+			{
+				const std::size_t index = (start + i) % capacity;
+				slot *slot_ptr = getSlot(index);
+				std::uint64_t state = slot_ptr->state.load(std::memory_order_relaxed);
+				if ((state & 3) != STATUS_FREE)
+				{
+					continue;
+				}
+				std::uint64_t generation = ((state >> 2) + 1) & 0xFFFF;
+				if (generation == 0)
+				{
+					generation = 1; // Generation 0 is never a valid Unique ID
+				}
+				slot_ptr->timestamp.store(now(), std::memory_order_relaxed); // Before CAS, so sweep never sees new ID with old timestamp
+				if (slot_ptr->state.compare_exchange_strong(state, ((generation << 2) | status), std::memory_order_acq_rel))
+				{
+					allocate_cursor.store(index + 1, std::memory_order_relaxed);
+					return static_cast<unsigned long>((generation << SLOT_INDEX_BITS) | index);
+				}
+			}
+		}
+		if (!grow(count))
+		{
+			return 0;
+		}
+	}
+}
+
+
+void ResultStore::store(slot *slot_ptr, std::string &&message)
+// Slot must be BUSY, replaces result with error message if Memory Limit is reached
+{
+	const std::size_t limit = max_bytes.load(std::memory_order_relaxed);
+	if ((limit > 0) && ((stored_bytes.load(std::memory_order_relaxed) + message.length()) > limit))
+	{
+		rejected_results.fetch_add(1, std::memory_order_relaxed);
+		message = "[0,\"Error Result Store Memory Limit\"]";
+	}
+	stored_bytes.fetch_add(message.length(), std::memory_order_relaxed);
+	stored_results.fetch_add(1, std::memory_order_relaxed);
+	slot_ptr->message = std::move(message);
+	slot_ptr->offset = 0;
+	slot_ptr->timestamp.store(now(), std::memory_order_relaxed);
+}
+
+
+void ResultStore::store(slot *slot_ptr, std::unique_ptr<ResultStream> &&stream)
+// Slot must be BUSY, Streams aren't counted against Memory Limit, they only buffer one part
+{
+	streams.fetch_add(1, std::memory_order_relaxed);
+	stored_results.fetch_add(1, std::memory_order_relaxed);
+	slot_ptr->stream = std::move(stream);
+	slot_ptr->offset = 0;
+	slot_ptr->timestamp.store(now(), std::memory_order_relaxed);
+}
+
+
+bool ResultStore::claim(const unsigned long &unique_id, slot *&slot_ptr)
+// WAIT -> BUSY, false if slot no longer belongs to unique_id
+{
+	const std::size_t index = unique_id & ((1 << SLOT_INDEX_BITS) - 1);
+	const std::uint64_t generation = (unique_id >> SLOT_INDEX_BITS) & 0xFFFF;
+	if ((generation == 0) || (index >= (segments_count.load(std::memory_order_acquire) * SEGMENT_SIZE)))
+	{
+		return false;
+	}
+	slot_ptr = getSlot(index);
+	std::uint64_t state = ((generation << 2) | STATUS_WAIT);
+	return slot_ptr->state.compare_exchange_strong(state, ((generation << 2) | STATUS_BUSY), std::memory_order_acquire);
+}
+
+
+unsigned long ResultStore::reserve()
+// Reserves slot for ASYNC + SAVE result, polling returns WAIT until complete
+{
+	return allocate(STATUS_WAIT);
+}
+
+
+unsigned long ResultStore::save(std::string &&message)
+// Stores result straight away, used by SYNC Calls where message > outputsize
+{
+	const unsigned long unique_id = allocate(STATUS_BUSY);
+	if (unique_id != 0)
+	{
+		slot *slot_ptr = getSlot(unique_id & ((1 << SLOT_INDEX_BITS) - 1));
+		store(slot_ptr, std::move(message));
+		slot_ptr->state.store(((slot_ptr->state.load(std::memory_order_relaxed) & ~std::uint64_t(3)) | STATUS_READY), std::memory_order_release);
+	}
+	return unique_id;
+}
+
+
+bool ResultStore::complete(const unsigned long &unique_id, std::string &&message)
+// Worker Thread stores result for reserved slot, returns false if slot no longer belongs to unique_id
+{
+	slot *slot_ptr;
+	if (!claim(unique_id, slot_ptr))
+	{
+		return false;
+	}
+	store(slot_ptr, std::move(message));
+	release(slot_ptr);
+	return true;
+}
+
+
+unsigned long ResultStore::saveStream(std::unique_ptr<ResultStream> &&stream)
+// Stores Stream straight away, used by SYNC Calls. Returns 0 if Result Store is Full (Stream is left with caller)
+{
+	const unsigned long unique_id = allocate(STATUS_BUSY);
+	if (unique_id != 0)
+	{
+		slot *slot_ptr = getSlot(unique_id & ((1 << SLOT_INDEX_BITS) - 1));
+		store(slot_ptr, std::move(stream));
+		release(slot_ptr);
+	}
+	return unique_id;
+}
+
+
+bool ResultStore::completeStream(const unsigned long &unique_id, std::unique_ptr<ResultStream> &&stream)
+// Worker Thread stores Stream for reserved slot, returns false if slot no longer belongs to unique_id (Stream is left with caller)
+{
+	slot *slot_ptr;
+	if (!claim(unique_id, slot_ptr))
+	{
+		return false;
+	}
+	store(slot_ptr, std::move(stream));
+	release(slot_ptr);
+	return true;
+}
+
+
+void ResultStore::queuePart(slot *slot_ptr)
+// Game Thread hands locked Stream slot to Lane, slot stays BUSY until storePart
+{
+	slot_ptr->part.store(Part::QUEUED, std::memory_order_release);
+}
+
+
+bool ResultStore::claimPart(slot *slot_ptr)
+// Only one caller builds a queued part, Lane Worker finding it claimed does nothing
+{
+	Part expected = Part::QUEUED;
+	return slot_ptr->part.compare_exchange_strong(expected, Part::BUILDING, std::memory_order_acquire);
+}
+
+
+void ResultStore::storePart(slot *slot_ptr, std::string &&part, const bool &more)
+// Stores next part of a Stream + unlocks slot
+{
+	if (!more)
+	{
+		slot_ptr->stream.reset();
+		streams.fetch_sub(1, std::memory_order_relaxed);
+		stored_bytes.fetch_add(part.length(), std::memory_order_relaxed);
+	}
+	slot_ptr->message = std::move(part);
+	slot_ptr->offset = 0;
+	slot_ptr->part.store(Part::STORED, std::memory_order_relaxed);
+	release(slot_ptr);
+}
+
+
+ResultStore::Status ResultStore::lock(const unsigned long &unique_id, slot *&slot_ptr)
+// Wait-free, single load + at most one CAS
+{
+	const std::size_t index = unique_id & ((1 << SLOT_INDEX_BITS) - 1);
+	const std::uint64_t generation = (unique_id >> SLOT_INDEX_BITS) & 0xFFFF;
+	if ((generation == 0) || (index >= (segments_count.load(std::memory_order_acquire) * SEGMENT_SIZE)))
+	{
+		return Status::NOT_FOUND;
+	}
+	slot_ptr = getSlot(index);
+	std::uint64_t state = slot_ptr->state.load(std::memory_order_acquire);
+	if ((state >> 2) != generation)
+	{
+		return Status::NOT_FOUND;
+	}
+	switch (state & 3)
+	{
+		case STATUS_WAIT:
+		case STATUS_BUSY:
+			return Status::WAIT;
+		case STATUS_READY:
+			if (slot_ptr->state.compare_exchange_strong(state, ((generation << 2) | STATUS_BUSY), std::memory_order_acquire))
+			{
+				return Status::READY;
+			}
+			return Status::WAIT;
+		default:
+			return Status::NOT_FOUND;
+	}
+}
+
+
+void ResultStore::release(slot *slot_ptr)
+// Unlock slot, result still stored
+{
+	slot_ptr->timestamp.store(now(), std::memory_order_relaxed);
+	slot_ptr->state.store(((slot_ptr->state.load(std::memory_order_relaxed) & ~std::uint64_t(3)) | STATUS_READY), std::memory_order_release);
+}
+
+
+void ResultStore::erase(slot *slot_ptr)
+// Frees slot, generation is bumped when slot is reused
+{
+	std::unique_ptr<ResultStream> stream;
+	erase(slot_ptr, stream);
+	stream.reset(); // Returns its Database Session
+}
+
+
+void ResultStore::erase(slot *slot_ptr, std::unique_ptr<ResultStream> &stream)
+// Frees slot, Stream is handed to caller
+{
+	stored_results.fetch_sub(1, std::memory_order_relaxed);
+	if (slot_ptr->stream)
+	{
+		stream = std::move(slot_ptr->stream);
+		streams.fetch_sub(1, std::memory_order_relaxed);
+	} else {
+		stored_bytes.fetch_sub(slot_ptr->message.length(), std::memory_order_relaxed);
+	}
+	std::string().swap(slot_ptr->message);
+	slot_ptr->offset = 0;
+	slot_ptr->part.store(Part::NONE, std::memory_order_relaxed);
+	slot_ptr->state.store((slot_ptr->state.load(std::memory_order_relaxed) & ~std::uint64_t(3)), std::memory_order_release);
+}
+
+
+void ResultStore::sweep(std::vector<std::unique_ptr<ResultStream>> &expired_streams)
+// Evicts READY results + WAIT reservations older than TTL, Streams older than Stream TTL
+//   Worker completing an evicted WAIT fails its CAS, result is dropped
+//   Streams are detached while slot is BUSY, caller frees them off the Timer Thread
+{
+	const std::int64_t result_ttl = ttl.load(std::memory_order_relaxed);
+	const std::int64_t result_stream_ttl = stream_ttl.load(std::memory_order_relaxed);
+	if ((result_ttl <= 0) && (result_stream_ttl <= 0))
+	{
+		return;
+	}
+	const std::int64_t current_time = now();
+	// Slots newer than the shorter TTL are skipped without locking them
+	const std::int64_t min_ttl = (result_ttl <= 0) ? result_stream_ttl : ((result_stream_ttl <= 0) ? result_ttl : std::min(result_ttl, result_stream_ttl));
+	const std::size_t capacity = segments_count.load(std::memory_order_acquire) * SEGMENT_SIZE;
+	for (std::size_t index = 0; index < capacity; ++index)
+	{
+		slot *slot_ptr = getSlot(index);
+		std::uint64_t state = slot_ptr->state.load(std::memory_order_acquire);
+		if (slot_ptr->timestamp.load(std::memory_order_relaxed) > (current_time - min_ttl))
+		{
+			continue;
+		}
+		switch (state & 3)
+		{
+			case STATUS_WAIT:
+				if ((result_ttl <= 0) || (slot_ptr->timestamp.load(std::memory_order_relaxed) > (current_time - result_ttl)))
+				{
+					break;
+				}
+				if (slot_ptr->state.compare_exchange_strong(state, (state & ~std::uint64_t(3)), std::memory_order_acq_rel))
+				{
+					evicted_waits.fetch_add(1, std::memory_order_relaxed);
+				}
+				break;
+			case STATUS_READY:
+				if (slot_ptr->state.compare_exchange_strong(state, ((state & ~std::uint64_t(3)) | STATUS_BUSY), std::memory_order_acquire))
+				{
+					const bool is_stream = static_cast<bool>(slot_ptr->stream);
+					const std::int64_t slot_ttl = is_stream ? result_stream_ttl : result_ttl;
+					if ((slot_ttl <= 0) || (slot_ptr->timestamp.load(std::memory_order_relaxed) > (current_time - slot_ttl)))
+					{
+						// Not expired / Fetched since first check, unlocked without touching timestamp
+						slot_ptr->state.store(((state & ~std::uint64_t(3)) | STATUS_READY), std::memory_order_release);
+					}	else {
+						std::unique_ptr<ResultStream> stream;
+						erase(slot_ptr, stream);
+						if (is_stream)
+						{
+							expired_streams.push_back(std::move(stream));
+							evicted_streams.fetch_add(1, std::memory_order_relaxed);
+						} else {
+							evicted_results.fetch_add(1, std::memory_order_relaxed);
+						}
+					}
+				}
+				break;
+		}
+	}
+}
+
+
+std::size_t ResultStore::eraseStreams()
+// Frees every Stream + its Database Session, returns count
+//   Only called while Worker + Timer Threads are stopped, Streams point into Protocols + Database Pools about to be freed
+{
+	std::size_t count = 0;
+	const std::size_t capacity = segments_count.load(std::memory_order_acquire) * SEGMENT_SIZE;
+	for (std::size_t index = 0; index < capacity; ++index)
+	{
+		slot *slot_ptr = getSlot(index);
+		if (((slot_ptr->state.load(std::memory_order_acquire) & 3) != STATUS_FREE) && (slot_ptr->stream))
+		{
+			erase(slot_ptr);
+			++count;
+		}
+	}
+	return count;
+}
+
+
+void ResultStore::getStatistics(statistics &stats)
+{
+	stats.stored_results = stored_results.load(std::memory_order_relaxed);
+	stats.stored_bytes = stored_bytes.load(std::memory_order_relaxed);
+	stats.evicted_results = evicted_results.load(std::memory_order_relaxed);
+	stats.evicted_waits = evicted_waits.load(std::memory_order_relaxed);
+	stats.rejected_results = rejected_results.load(std::memory_order_relaxed);
+	stats.streams = streams.load(std::memory_order_relaxed);
+	stats.evicted_streams = evicted_streams.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,129 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+class Executor;
+
+
+class ResultStream
+// Result produced on demand, one 5: part at a time i.e rows pulled from the Database as SQF fetches them
+//   Parts are built on a Lane Worker Thread while its Result Store slot is BUSY, Game Thread only copies finished parts
+{
+public:
+	virtual ~ResultStream() {}
+
+	// Builds next part (max part_size bytes) into part, returns false once part is the last one
+	//   Parts never end mid UTF-8 sequence
+	virtual bool next(std::string &part, const std::size_t &part_size) = 0;
+
+	Executor *lane = nullptr;  // Lane building parts
+};
+
+
+class ResultStore
+// Lock-free Slot Table for Stored Results
+//   Unique ID = Slot Generation + Slot Index, stale IDs never match a reused slot
+//   Slot State = Generation + Status, all transitions are a single CAS / store. No locks, no retry loops on lookup
+{
+public:
+	ResultStore();
+	~ResultStore();
+
+	enum class Status { NOT_FOUND, WAIT, READY };
+	// Stream Part handed to Lane -- QUEUED can be claimed by Lane Worker or Game Thread, whichever gets there first
+	enum class Part { NONE, QUEUED, BUILDING, STORED };
+
+	struct slot
+	{
+		std::atomic<std::uint64_t> state{0};
+		std::string message;       // Immutable once READY
+		std::size_t offset = 0;    // Multi-Part Cursor into message
+		std::atomic<std::int64_t> timestamp{0};  // Last Status change, steady_clock seconds
+		std::unique_ptr<ResultStream> stream;    // Streaming Result, message = current part (not counted in stored_bytes)
+		std::atomic<Part> part{Part::NONE};      // NONE until first Stream part is queued, slot BUSY + != NONE = part is on its way
+	};
+
+	struct statistics
+	{
+		std::size_t stored_results;
+		std::size_t stored_bytes;
+		std::size_t evicted_results;       // READY results not fetched before TTL
+		std::size_t evicted_waits;         // Reserved IDs the worker never completed before TTL
+		std::size_t rejected_results;      // Results replaced by error, Memory Limit reached
+		std::size_t streams;               // Streaming Results still holding a Database Session
+		std::size_t evicted_streams;       // Streams not fetched again within Stream TTL
+	};
+
+	// TTL 0 / Max Bytes 0 = Disabled
+	//   Streams hold a Database Session, so they get their own (shorter) TTL, counted from last 5: fetch
+	void setLimits(const std::chrono::seconds &ttl, const std::size_t &max_bytes, const std::chrono::seconds &stream_ttl);
+	// Expired Streams are handed back, freeing one reads its unread rows from the Server
+	void sweep(std::vector<std::unique_ptr<ResultStream>> &expired_streams);
+	std::size_t eraseStreams();
+	void getStatistics(statistics &stats);
+
+	// Worker / Game Thread
+	unsigned long reserve();
+	unsigned long save(std::string &&message);
+	bool complete(const unsigned long &unique_id, std::string &&message);
+	unsigned long saveStream(std::unique_ptr<ResultStream> &&stream);
+	bool completeStream(const unsigned long &unique_id, std::unique_ptr<ResultStream> &&stream);
+	// Slot handed over BUSY by Game Thread, last part turns slot into a plain Result
+	void queuePart(slot *slot_ptr);
+	bool claimPart(slot *slot_ptr);  // QUEUED -> BUILDING
+	void storePart(slot *slot_ptr, std::string &&part, const bool &more);
+
+	// Game Thread
+	//   READY locks slot for caller, must be followed by release or erase
+	Status lock(const unsigned long &unique_id, slot *&slot_ptr);
+	void release(slot *slot_ptr);
+	void erase(slot *slot_ptr);
+
+private:
+	static const std::uint64_t STATUS_FREE = 0;
+	static const std::uint64_t STATUS_WAIT = 1;
+	static const std::uint64_t STATUS_READY = 2;
+	static const std::uint64_t STATUS_BUSY = 3;
+
+	static const unsigned int SLOT_INDEX_BITS = 16;
+	static const std::size_t SEGMENT_SIZE = 1024;
+	static const std::size_t MAX_SEGMENTS = (std::size_t(1) << SLOT_INDEX_BITS) / SEGMENT_SIZE;
+
+	// Segments are allocated on demand and never moved / freed until destruction
+	std::atomic<slot *> segments[MAX_SEGMENTS];
+	std::atomic<std::size_t> segments_count{0};
+	std::atomic<std::size_t> allocate_cursor{0};
+
+	// Limits + Counters
+	std::atomic<std::int64_t> ttl{0};
+	std::atomic<std::int64_t> stream_ttl{0};
+	std::atomic<std::size_t> max_bytes{0};
+	std::atomic<std::size_t> stored_results{0};
+	std::atomic<std::size_t> stored_bytes{0};
+	std::atomic<std::size_t> evicted_results{0};
+	std::atomic<std::size_t> evicted_waits{0};
+	std::atomic<std::size_t> rejected_results{0};
+	std::atomic<std::size_t> streams{0};
+	std::atomic<std::size_t> evicted_streams{0};
+
+	static std::int64_t now();
+	void store(slot *slot_ptr, std::string &&message);
+	void store(slot *slot_ptr, std::unique_ptr<ResultStream> &&stream);
+	bool claim(const unsigned long &unique_id, slot *&slot_ptr);  // WAIT -> BUSY
+	void erase(slot *slot_ptr, std::unique_ptr<ResultStream> &stream);  // Stream is moved out instead of freed
+
+	unsigned long allocate(const std::uint64_t &status);
+	slot *getSlot(const std::size_t &index);
+	bool grow(const std::size_t &current_count);
+};
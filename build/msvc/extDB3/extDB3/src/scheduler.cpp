@@ -0,0 +1,205 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "scheduler.h"
+
+#include <algorithm>
+
+
+thread_local WorkStealingScheduler *WorkStealingScheduler::current_scheduler = nullptr;
+thread_local std::size_t WorkStealingScheduler::current_index = 0;
+
+
+WorkStealingScheduler::WorkStealingScheduler()
+{
+}
+
+
+WorkStealingScheduler::~WorkStealingScheduler(void)
+{
+	stop();
+}
+
+
+void WorkStealingScheduler::start(const int &threads_count, const int &max_threads, std::function<void()> init)
+{
+	stopping = false;
+	thread_init = init;
+	const std::size_t max_size = static_cast<std::size_t>(std::max(max_threads, threads_count));
+	worker_queues.clear();
+	threads.clear();
+	threads_running.reset(new std::atomic<bool>[max_size]);
+	for (std::size_t i = 0; i < max_size; ++i)
+	{
+		worker_queues.emplace_back(new task_queue());
+		threads.emplace_back();
+		threads_running[i] = false;
+	}
+	target_threads = threads_count;
+	for (int i = 0; i < threads_count; ++i)
+	{
+		spawn(static_cast<std::size_t>(i));
+	}
+}
+
+
+void WorkStealingScheduler::spawn(const std::size_t &index)
+{
+	if (threads[index].joinable())
+	{
+		threads[index].join(); // Retired Worker
+	}
+	threads_running[index] = true;
+	threads[index] = std::thread(&WorkStealingScheduler::run, this, index);
+}
+
+
+void WorkStealingScheduler::resize(int threads_count)
+// Workers decide to retire + clear threads_running under mutex_sleep, so check + spawn here can't miss a Worker retiring below new target
+{
+	threads_count = std::min(std::max(threads_count, 1), static_cast<int>(threads.size()));
+	std::lock_guard<std::mutex> lock(mutex_sleep);
+	target_threads = threads_count;
+	cv_sleep.notify_all(); // Wake Workers above target, so they can retire
+	for (int i = 0; i < threads_count; ++i)
+	{
+		if (!threads_running[i])
+		{
+			spawn(static_cast<std::size_t>(i)); // Retired Worker never takes mutex_sleep again, join can't deadlock
+		}
+	}
+}
+
+
+int WorkStealingScheduler::getThreads() const
+{
+	return target_threads.load();
+}
+
+
+void WorkStealingScheduler::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_sleep);
+		stopping = true;
+	}
+	cv_sleep.notify_all();
+	for (auto &thread : threads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+	threads.clear();
+}
+
+
+void WorkStealingScheduler::post(std::function<void()> &&task)
+// Worker Threads push to own deque, anyone else uses Injection Queue
+{
+	if (current_scheduler == this)
+	{
+		task_queue &worker_queue = *worker_queues[current_index];
+		std::lock_guard<std::mutex> lock(worker_queue.mutex);
+		worker_queue.tasks.push_back(std::move(task));
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock(injection_queue.mutex);
+		injection_queue.tasks.push_back(std::move(task));
+	}
+	// seq_cst: either a sleeping Worker sees queued > 0, or we see sleeping > 0 + wake it
+	queued.fetch_add(1);
+	if (sleeping.load() > 0)
+	{
+		std::lock_guard<std::mutex> lock(mutex_sleep);
+		cv_sleep.notify_one();
+	}
+}
+
+
+std::size_t WorkStealingScheduler::size() const
+{
+	return queued.load(std::memory_order_relaxed);
+}
+
+
+bool WorkStealingScheduler::pop(const std::size_t &index, std::function<void()> &task)
+// Own deque (newest first, still hot in cache) -> Injection Queue -> Steal oldest from other Workers
+{
+	{
+		task_queue &worker_queue = *worker_queues[index];
+		std::lock_guard<std::mutex> lock(worker_queue.mutex);
+		if (!worker_queue.tasks.empty())
+		{
+			task = std::move(worker_queue.tasks.back());
+			worker_queue.tasks.pop_back();
+			queued.fetch_sub(1);
+			return true;
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(injection_queue.mutex);
+		if (!injection_queue.tasks.empty())
+		{
+			task = std::move(injection_queue.tasks.front());
+			injection_queue.tasks.pop_front();
+			queued.fetch_sub(1);
+			return true;
+		}
+	}
+	for (std::size_t i = 1; i < worker_queues.size(); ++i)
+	{
+		task_queue &victim_queue = *worker_queues[(index + i) % worker_queues.size()];
+		std::unique_lock<std::mutex> lock(victim_queue.mutex, std::try_to_lock);
+		if ((lock.owns_lock()) && (!victim_queue.tasks.empty()))
+		{
+			task = std::move(victim_queue.tasks.front());
+			victim_queue.tasks.pop_front();
+			queued.fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void WorkStealingScheduler::run(const std::size_t index)
+{
+	current_scheduler = this;
+	current_index = index;
+	if (thread_init)
+	{
+		thread_init();
+	}
+
+	std::function<void()> task;
+	while (true)
+	{
+		if (pop(index, task))
+		{
+			task();
+			task = nullptr;
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex_sleep);
+		sleeping.fetch_add(1);
+		if (queued.load() == 0)
+		{
+			if ((stopping) || (index >= static_cast<std::size_t>(target_threads.load())))
+			{
+				// Stopped or Retired, own deque is empty + only this thread pushes to it
+				sleeping.fetch_sub(1);
+				threads_running[index] = false;
+				break;
+			}
+			cv_sleep.wait(lock);
+		}
+		sleeping.fetch_sub(1);
+	}
+	current_scheduler = nullptr;
+}
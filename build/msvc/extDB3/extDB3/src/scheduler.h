@@ -0,0 +1,65 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class WorkStealingScheduler
+// Work-Stealing Thread Pool
+//   Each Worker has its own deque (LIFO for own tasks, others steal FIFO), Game Thread submits via Injection Queue
+//   Workers only touch a shared lock when stealing / injecting, instead of every post + dequeue contending on one queue
+//   Thread count can be resized at runtime up to max_threads, retired Workers exit once idle
+{
+public:
+	WorkStealingScheduler();
+	~WorkStealingScheduler();
+
+	void start(const int &threads_count, const int &max_threads, std::function<void()> init);
+	void stop();  // Runs all queued tasks, then joins Worker Threads
+
+	// Not thread-safe against start / stop, only called from one thread (Timer Thread)
+	void resize(int threads_count);
+	int getThreads() const;
+
+	void post(std::function<void()> &&task);
+	std::size_t size() const;
+
+private:
+	struct task_queue
+	{
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	std::vector<std::unique_ptr<task_queue>> worker_queues;  // Allocated for max_threads, never resized while running
+	task_queue injection_queue;
+	std::vector<std::thread> threads;
+	std::unique_ptr<std::atomic<bool>[]> threads_running;
+	std::atomic<int> target_threads{0};
+	std::function<void()> thread_init;
+
+	std::atomic<std::size_t> queued{0};
+	std::atomic<int> sleeping{0};
+	std::atomic<bool> stopping{false};
+	std::mutex mutex_sleep;
+	std::condition_variable cv_sleep;
+
+	// Worker Thread -> own Queue Index
+	static thread_local WorkStealingScheduler *current_scheduler;
+	static thread_local std::size_t current_index;
+
+	void spawn(const std::size_t &index);
+	void run(const std::size_t index);
+	bool pop(const std::size_t &index, std::function<void()> &task);
+};
@@ -3,13 +3,55 @@
  * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
  */
 
+#include <atomic>
+#include <chrono>
 #include <string>
 
 #include <boost/algorithm/string.hpp>
 
 #include "ext.h"
+#include "executor.h"
 
 #ifdef TEST_APP
+	void bench(Ext *extension)
+	// Executor Throughput, ASIO io_service vs Work-Stealing Scheduler
+	//   Game Thread posts tasks, each task builds a small result string + posts a follow-up task (same as ASYNC + SAVE)
+	{
+		const int tasks = 200000;
+		const int threads_counts[] = {1, 2, 4, 8};
+		const int schedulers[] = {Executor::ASIO, Executor::WORK_STEALING};
+		for (auto &scheduler : schedulers)
+		{
+			for (auto &threads_count : threads_counts)
+			{
+				std::atomic<int> completed(0);
+				Executor executor("Bench", threads_count, Executor::NORMAL, scheduler);
+				executor.start();
+
+				auto start = std::chrono::steady_clock::now();
+				for (int i = 0; i < tasks; ++i)
+				{
+					executor.post([&executor, &completed, i]()
+					{
+						std::string result = "[1,[[" + std::to_string(i) + ",\"bench\"]]]";
+						executor.post([&completed, result]()
+						{
+							if (!result.empty())
+							{
+								++completed;
+							}
+						});
+					});
+				}
+				executor.stop();
+				auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+				extension->console->info("Bench: {0} Threads: {1} Tasks: {2} Time: {3}ms Tasks/s: {4}", (scheduler == Executor::ASIO) ? "ASIO" : "Work Stealing", threads_count, completed.load() * 2, elapsed, (elapsed > 0) ? ((completed.load() * 2000LL) / elapsed) : 0);
+			}
+		}
+	}
+
+
 	int main(int nNumberofArgs, char* pszArgs[])
 	{
 		int result_size = 80;
@@ -33,6 +75,10 @@
 			{
 				test = true;
 			}
+			else if (boost::algorithm::iequals(input_str, "Bench") == 1)
+			{
+				bench(extension);
+			}
 			else
 			{
 				extension->callExtension(result, result_size, input_str.c_str());
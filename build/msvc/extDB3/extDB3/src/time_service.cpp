@@ -0,0 +1,289 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "time_service.h"
+
+#include <charconv>
+#include <cstring>
+
+
+thread_local TimeService::time_cache TimeService::cache;
+
+
+TimeService::TimeService()
+{
+	uptime_start = std::chrono::steady_clock::now();
+}
+
+
+std::int64_t TimeService::now(const int &clock)
+// Civil Time as Seconds since 1970-01-01, localtime only recalculated once per second per Thread
+{
+	const std::time_t seconds = std::time(nullptr);
+	if (clock == UTC)
+	{
+		return static_cast<std::int64_t>(seconds);
+	}
+	if (cache.seconds != seconds)
+	{
+		std::tm tm_local;
+		#ifdef _WIN32
+			localtime_s(&tm_local, &seconds);
+		#else
+			localtime_r(&seconds, &tm_local);
+		#endif
+		cache.local_seconds = (daysFromCivil(tm_local.tm_year + 1900, tm_local.tm_mon + 1, tm_local.tm_mday) * 86400) +
+			(tm_local.tm_hour * 3600) + (tm_local.tm_min * 60) + tm_local.tm_sec;
+		cache.seconds = seconds;
+	}
+	return cache.local_seconds;
+}
+
+
+std::int64_t TimeService::daysFromCivil(std::int64_t year, const int &month, const int &day)
+// Howard Hinnant's days_from_civil, Proleptic Gregorian Calendar
+{
+	year -= (month <= 2) ? 1 : 0;
+	const std::int64_t era = ((year >= 0) ? year : (year - 399)) / 400;
+	const unsigned int year_of_era = static_cast<unsigned int>(year - (era * 400));
+	const unsigned int day_of_year = ((153 * (month + ((month > 2) ? -3 : 9)) + 2) / 5) + day - 1;
+	const unsigned int day_of_era = (year_of_era * 365) + (year_of_era / 4) - (year_of_era / 100) + day_of_year;
+	return (era * 146097) + static_cast<std::int64_t>(day_of_era) - 719468;
+}
+
+
+void TimeService::civilFromDays(std::int64_t days, std::int64_t &year, int &month, int &day)
+// Howard Hinnant's civil_from_days
+{
+	days += 719468;
+	const std::int64_t era = ((days >= 0) ? days : (days - 146096)) / 146097;
+	const unsigned int day_of_era = static_cast<unsigned int>(days - (era * 146097));
+	const unsigned int year_of_era = (day_of_era - (day_of_era / 1460) + (day_of_era / 36524) - (day_of_era / 146096)) / 365;
+	const unsigned int day_of_year = day_of_era - ((365 * year_of_era) + (year_of_era / 4) - (year_of_era / 100));
+	const unsigned int month_pos = ((5 * day_of_year) + 2) / 153;
+	day = static_cast<int>(day_of_year - (((153 * month_pos) + 2) / 5) + 1);
+	month = static_cast<int>((month_pos < 10) ? (month_pos + 3) : (month_pos - 9));
+	year = static_cast<std::int64_t>(year_of_era) + (era * 400) + ((month <= 2) ? 1 : 0);
+}
+
+
+bool TimeService::parseInt(std::string_view token, int &value)
+// Same leniency as std::stoi, leading spaces / + sign allowed + trailing characters ignored
+{
+	while ((!token.empty()) && (token.front() == ' '))
+	{
+		token.remove_prefix(1);
+	}
+	if ((!token.empty()) && (token.front() == '+'))
+	{
+		token.remove_prefix(1);
+	}
+	const auto parsed = std::from_chars(token.data(), token.data() + token.size(), value);
+	return ((parsed.ec == std::errc()) && (parsed.ptr != token.data()));
+}
+
+
+int TimeService::parseArray(std::string_view input_str, int *values, const int &max_values)
+// [1,2,3] -> values, returns count or -1 if invalid
+{
+	if ((input_str.size() < 2) || (input_str.front() != '[') || (input_str.back() != ']'))
+	{
+		return -1;
+	}
+	input_str.remove_prefix(1);
+	input_str.remove_suffix(1);
+
+	int count = 0;
+	while (true)
+	{
+		const std::string_view::size_type found = input_str.find(',');
+		if ((count >= max_values) || (!parseInt(input_str.substr(0, found), values[count])))
+		{
+			return -1;
+		}
+		++count;
+		if (found == std::string_view::npos)
+		{
+			return count;
+		}
+		input_str.remove_prefix(found + 1);
+	}
+}
+
+
+char *TimeService::formatInt(char *output, std::int64_t value, const int &width)
+// Zero padded to width, returns end of output
+{
+	if (value < 0)
+	{
+		*output++ = '-';
+		value = -value;
+	}
+	char digits[20];
+	int length = 0;
+	do
+	{
+		digits[length++] = static_cast<char>('0' + (value % 10));
+		value /= 10;
+	} while (value > 0);
+	while (length < width)
+	{
+		digits[length++] = '0';
+	}
+	while (length > 0)
+	{
+		*output++ = digits[--length];
+	}
+	return output;
+}
+
+
+void TimeService::format(char *output, const std::int64_t &civil_seconds)
+// [1,[%Y,%m,%d,%H,%M,%S]]
+{
+	std::int64_t days = civil_seconds / 86400;
+	std::int64_t seconds = civil_seconds % 86400;
+	if (seconds < 0)
+	{
+		seconds += 86400;
+		--days;
+	}
+	std::int64_t year;
+	int month, day;
+	civilFromDays(days, year, month, day);
+
+	std::memcpy(output, "[1,[", 4);
+	output = formatInt(output + 4, year, 4);
+	*output++ = ',';
+	output = formatInt(output, month, 2);
+	*output++ = ',';
+	output = formatInt(output, day, 2);
+	*output++ = ',';
+	output = formatInt(output, seconds / 3600, 2);
+	*output++ = ',';
+	output = formatInt(output, (seconds / 60) % 60, 2);
+	*output++ = ',';
+	output = formatInt(output, seconds % 60, 2);
+	std::memcpy(output, "]]", 3);
+}
+
+
+bool TimeService::getTime(char *output, const int &clock) const
+{
+	format(output, now(clock));
+	return true;
+}
+
+
+bool TimeService::getTime(char *output, const int &clock, std::string_view offset_str) const
+{
+	if (offset_str.empty())
+	{
+		return getTime(output, clock);
+	}
+
+	std::int64_t offset = 0;
+	if (offset_str.front() == '[')
+	{
+		int values[6];
+		const int count = parseArray(offset_str, values, 6);
+		if (count < 0)
+		{
+			std::strcpy(output, "[0,\"ERROR\"]");
+			return false;
+		}
+		if (count > 2)
+		{
+			offset += static_cast<std::int64_t>(values[2]) * 86400;
+		}
+		if (count > 3)
+		{
+			offset += static_cast<std::int64_t>(values[3]) * 3600;
+		}
+		if (count > 4)
+		{
+			offset += static_cast<std::int64_t>(values[4]) * 60;
+		}
+		if (count > 5)
+		{
+			offset += values[5];
+		}
+	}
+	else
+	{
+		int hours;
+		if (!parseInt(offset_str, hours))
+		{
+			std::strcpy(output, "[0,\"ERROR\"]");
+			return false;
+		}
+		offset = static_cast<std::int64_t>(hours) * 3600;
+	}
+	format(output, now(clock) + offset);
+	return true;
+}
+
+
+bool TimeService::getDateAdd(char *output, std::string_view date_str, std::string_view offset_str) const
+{
+	int date[6];
+	int offset[4];
+	if ((parseArray(date_str, date, 6) != 6) || (parseArray(offset_str, offset, 4) != 4))
+	{
+		std::strcpy(output, "[0,\"Error Invalid Format\"]");
+		return false;
+	}
+
+	// Same range as boost::posix_time::ptime
+	static const int days_in_month[12] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	if ((date[0] < 1400) || (date[0] > 9999) || (date[1] < 1) || (date[1] > 12) || (date[2] < 1) || (date[2] > days_in_month[date[1] - 1]) ||
+		((date[1] == 2) && (date[2] == 29) && (!(((date[0] % 4) == 0) && (((date[0] % 100) != 0) || ((date[0] % 400) == 0))))) ||
+		(date[3] < 0) || (date[3] > 23) || (date[4] < 0) || (date[4] > 59) || (date[5] < 0) || (date[5] > 59))
+	{
+		std::strcpy(output, "[0,\"Error Invalid Format\"]");
+		return false;
+	}
+
+	const std::int64_t civil_seconds = (daysFromCivil(date[0], date[1], date[2]) * 86400) + (date[3] * 3600) + (date[4] * 60) + date[5];
+	format(output, civil_seconds + (static_cast<std::int64_t>(offset[0]) * 86400) + (static_cast<std::int64_t>(offset[1]) * 3600) +
+		(static_cast<std::int64_t>(offset[2]) * 60) + offset[3]);
+	return true;
+}
+
+
+bool TimeService::getUPTime(char *output, std::string_view unit_str, const bool &array) const
+{
+	const auto uptime_diff = std::chrono::steady_clock::now() - uptime_start;
+	std::int64_t uptime;
+	if (unit_str == "SECONDS")
+	{
+		uptime = std::chrono::duration_cast<std::chrono::seconds>(uptime_diff).count();
+	}
+	else if (unit_str == "MINUTES")
+	{
+		uptime = std::chrono::duration_cast<std::chrono::minutes>(uptime_diff).count();
+	}
+	else if (unit_str == "HOURS")
+	{
+		uptime = std::chrono::duration_cast<std::chrono::hours>(uptime_diff).count();
+	}
+	else
+	{
+		std::strcpy(output, "[0,\"Error Invalid Format\"]");
+		return false;
+	}
+
+	if (array)
+	{
+		std::memcpy(output, "[1,", 3);
+		output = formatInt(output + 3, uptime, 1);
+		std::memcpy(output, "]", 2);
+	}
+	else
+	{
+		*formatInt(output, uptime, 1) = '\0';
+	}
+	return true;
+}
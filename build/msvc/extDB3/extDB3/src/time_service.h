@@ -0,0 +1,52 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string_view>
+
+
+class TimeService
+// LOCAL_TIME / UTC_TIME / DATEADD / UPTIME
+//   Formats straight into output, no streams / locales / heap. Only state is a per Thread cache of the current second
+{
+public:
+	TimeService();
+
+	enum Clock { LOCAL, UTC };
+
+	// [1,[Y,M,D,h,m,s]]
+	//   offset_str = Hours or [Years,Months,Days,Hours,Minutes,Seconds] (Years + Months are ignored)
+	bool getTime(char *output, const int &clock) const;
+	bool getTime(char *output, const int &clock, std::string_view offset_str) const;
+
+	// [Y,M,D,h,m,s] + [Days,Hours,Minutes,Seconds]
+	bool getDateAdd(char *output, std::string_view date_str, std::string_view offset_str) const;
+
+	// unit_str = SECONDS / MINUTES / HOURS,  UPTIME returns bare number, UPTIME2 returns [1,number]
+	bool getUPTime(char *output, std::string_view unit_str, const bool &array) const;
+
+private:
+	struct time_cache
+	{
+		std::time_t seconds = -1;
+		std::int64_t local_seconds = 0;  // Local Civil Time, as Seconds since 1970-01-01
+	};
+	static thread_local time_cache cache;
+
+	std::chrono::steady_clock::time_point uptime_start;
+
+	static std::int64_t now(const int &clock);
+	static std::int64_t daysFromCivil(std::int64_t year, const int &month, const int &day);
+	static void civilFromDays(std::int64_t days, std::int64_t &year, int &month, int &day);
+
+	static bool parseInt(std::string_view token, int &value);
+	static int parseArray(std::string_view input_str, int *values, const int &max_values);
+	static char *formatInt(char *output, std::int64_t value, const int &width);
+	static void format(char *output, const std::int64_t &civil_seconds);
+};